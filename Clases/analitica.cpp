@@ -0,0 +1,199 @@
+#include "analitica.h"
+#include <stdexcept>
+#include "ciudades.h"
+
+AcumuladoGrupo::AcumuladoGrupo()
+    : total(0), declarantes(0), masLongeva(SIN_INDICE),
+      maxPatrimonio(SIN_INDICE), minPatrimonio(SIN_INDICE), maxDeuda(SIN_INDICE) {}
+
+// Columnas que consulta el acumulador, leídas una sola vez del almacén
+struct Columnas {
+    const double* patrimonio;
+    const double* deudas;
+    const std::int32_t* fecha;
+};
+
+// Incorpora la fila i al grupo. Solo reemplaza con desigualdad estricta para
+// conservar la primera fila en empates.
+static inline void acumular(AcumuladoGrupo& g, const Columnas& c, std::uint32_t i, bool declara) {
+    if (g.total == 0) {
+        g.masLongeva = g.maxPatrimonio = g.minPatrimonio = g.maxDeuda = i;
+    } else {
+        if (c.fecha[i] < c.fecha[g.masLongeva]) g.masLongeva = i;
+        if (c.patrimonio[g.maxPatrimonio] < c.patrimonio[i]) g.maxPatrimonio = i;
+        if (c.patrimonio[i] < c.patrimonio[g.minPatrimonio]) g.minPatrimonio = i;
+        if (c.deudas[g.maxDeuda] < c.deudas[i]) g.maxDeuda = i;
+    }
+    ++g.total;
+    if (declara) ++g.declarantes;
+}
+
+// Mezcla un grupo de filas posteriores; con igualdad se queda el de 'g'
+static void mezclarGrupo(AcumuladoGrupo& g, const AcumuladoGrupo& posterior, const Columnas& c) {
+    if (posterior.total == 0) return;
+    if (g.total == 0) {
+        g = posterior;
+        return;
+    }
+    if (c.fecha[posterior.masLongeva] < c.fecha[g.masLongeva]) g.masLongeva = posterior.masLongeva;
+    if (c.patrimonio[g.maxPatrimonio] < c.patrimonio[posterior.maxPatrimonio]) g.maxPatrimonio = posterior.maxPatrimonio;
+    if (c.patrimonio[posterior.minPatrimonio] < c.patrimonio[g.minPatrimonio]) g.minPatrimonio = posterior.minPatrimonio;
+    if (c.deudas[g.maxDeuda] < c.deudas[posterior.maxDeuda]) g.maxDeuda = posterior.maxDeuda;
+    g.total += posterior.total;
+    g.declarantes += posterior.declarantes;
+}
+
+static Columnas columnasDe(const PersonaStore& store) {
+    Columnas c;
+    c.patrimonio = store.getPatrimonio();
+    c.deudas = store.getDeudas();
+    c.fecha = store.getFechaNacimiento();
+    return c;
+}
+
+ReporteAnalitico reporteVacio() {
+    ReporteAnalitico reporte;
+    reporte.porCiudad.assign(totalCiudades(), AcumuladoGrupo());
+    for (int g = 0; g < 3; ++g) {
+        reporte.declarantesCalendario[g] = 0;
+        reporte.primerDeclaranteCalendario[g] = SIN_INDICE;
+    }
+    return reporte;
+}
+
+void acumularRango(ReporteAnalitico& reporte, const PersonaStore& store,
+                   std::size_t inicio, std::size_t fin) {
+    if (store.size() >= SIN_INDICE) {
+        throw std::length_error("Demasiadas personas para índices de 32 bits");
+    }
+
+    const Columnas c = columnasDe(store);
+    const std::uint64_t* id = store.getId();
+    const CodigoCiudad* ciudad = store.getCiudad();
+    const std::uint8_t* declarante = store.getDeclaranteRenta();
+
+    const std::uint32_t hasta = static_cast<std::uint32_t>(fin);
+    for (std::uint32_t i = static_cast<std::uint32_t>(inicio); i < hasta; ++i) {
+        const bool declara = declarante[i] != 0;
+        const int grupo = Persona::indiceGrupoDIAN(id[i]);
+
+        acumular(reporte.pais, c, i, declara);
+        acumular(reporte.porCiudad[ciudad[i]], c, i, declara);
+        acumular(reporte.porGrupoDIAN[grupo], c, i, declara);
+
+        if (declara) {
+            if (reporte.declarantesCalendario[grupo]++ == 0) {
+                reporte.primerDeclaranteCalendario[grupo] = i;
+            }
+        }
+    }
+}
+
+void mezclarReporte(ReporteAnalitico& destino, const ReporteAnalitico& posterior,
+                    const PersonaStore& store) {
+    const Columnas c = columnasDe(store);
+
+    mezclarGrupo(destino.pais, posterior.pais, c);
+    for (std::size_t codigo = 0; codigo < posterior.porCiudad.size(); ++codigo) {
+        mezclarGrupo(destino.porCiudad[codigo], posterior.porCiudad[codigo], c);
+    }
+    for (int g = 0; g < 3; ++g) {
+        mezclarGrupo(destino.porGrupoDIAN[g], posterior.porGrupoDIAN[g], c);
+        destino.declarantesCalendario[g] += posterior.declarantesCalendario[g];
+        if (destino.primerDeclaranteCalendario[g] == SIN_INDICE) {
+            destino.primerDeclaranteCalendario[g] = posterior.primerDeclaranteCalendario[g];
+        }
+    }
+}
+
+ReporteAnalitico generarReporte(const PersonaStore& store) {
+    ReporteAnalitico reporte = reporteVacio();
+    acumularRango(reporte, store, 0, store.size());
+    return reporte;
+}
+
+// --- Totales de dinero exactos ---
+
+TotalesDinero::TotalesDinero() : personas(0), ingresos(0), patrimonio(0), deudas(0) {}
+
+SumaCentavos TotalesDinero::patrimonioNeto() const {
+    return patrimonio - deudas;
+}
+
+static void sumarTotales(TotalesDinero& destino, const TotalesDinero& otro) {
+    destino.personas += otro.personas;
+    destino.ingresos += otro.ingresos;
+    destino.patrimonio += otro.patrimonio;
+    destino.deudas += otro.deudas;
+}
+
+ReporteDinero reporteDineroVacio() {
+    ReporteDinero reporte;
+    reporte.porCiudad.assign(totalCiudades(), TotalesDinero());
+    return reporte;
+}
+
+void acumularDineroRango(ReporteDinero& reporte, const PersonaStore& store,
+                         std::size_t inicio, std::size_t fin) {
+    if (!store.tieneCentavos()) {
+        throw std::runtime_error("El almacén no tiene columnas en centavos (ver materializarCentavos)");
+    }
+    const Centavos* ingresos = store.getIngresosCentavos();
+    const Centavos* patrimonio = store.getPatrimonioCentavos();
+    const Centavos* deudas = store.getDeudasCentavos();
+    const CodigoCiudad* ciudad = store.getCiudad();
+
+    // Solo se acumula por ciudad; el país es la suma de las ciudades del rango
+    ReporteDinero rango = reporteDineroVacio();
+    for (std::size_t i = inicio; i < fin; ++i) {
+        TotalesDinero& t = rango.porCiudad[ciudad[i]];
+        ++t.personas;
+        t.ingresos += ingresos[i];
+        t.patrimonio += patrimonio[i];
+        t.deudas += deudas[i];
+    }
+    for (std::size_t codigo = 0; codigo < rango.porCiudad.size(); ++codigo) {
+        sumarTotales(rango.pais, rango.porCiudad[codigo]);
+    }
+    mezclarReporteDinero(reporte, rango);
+}
+
+void mezclarReporteDinero(ReporteDinero& destino, const ReporteDinero& otro) {
+    sumarTotales(destino.pais, otro.pais);
+    for (std::size_t codigo = 0; codigo < otro.porCiudad.size(); ++codigo) {
+        sumarTotales(destino.porCiudad[codigo], otro.porCiudad[codigo]);
+    }
+}
+
+ReporteDinero generarReporteDinero(const PersonaStore& store) {
+    ReporteDinero reporte = reporteDineroVacio();
+    acumularDineroRango(reporte, store, 0, store.size());
+    return reporte;
+}
+
+SumaCentavos promedioCentavos(SumaCentavos total, std::uint64_t personas) {
+    if (personas == 0) return 0;
+    const SumaCentavos n = personas;
+    return total >= 0 ? (total + n / 2) / n : -((-total + n / 2) / n);
+}
+
+std::string textoCentavos(SumaCentavos centavos) {
+    __extension__ typedef unsigned __int128 Magnitud;
+    Magnitud magnitud = centavos < 0 ? -static_cast<Magnitud>(centavos) : static_cast<Magnitud>(centavos);
+
+    // Dígitos de derecha a izquierda; los dos primeros son los centavos
+    char digitos[48];
+    int n = 0;
+    do {
+        digitos[n++] = static_cast<char>('0' + static_cast<int>(magnitud % 10));
+        magnitud /= 10;
+    } while (magnitud != 0 || n < 3);
+
+    std::string texto;
+    if (centavos < 0) texto += '-';
+    while (n > 2) texto += digitos[--n];
+    texto += '.';
+    texto += digitos[1];
+    texto += digitos[0];
+    return texto;
+}
@@ -0,0 +1,100 @@
+#ifndef ANALITICA_H
+#define ANALITICA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "persona_store.h"
+
+// Motor analítico de una sola pasada: calcula en un único recorrido sobre el
+// almacén columnar todos los agregados del reporte "todos los métodos"
+// (extremos nacionales, por ciudad, por grupo de declaración y calendario).
+// Los resultados son índices de fila; en empates gana la primera fila, igual
+// que las consultas individuales de Persona.
+
+// Índice de fila inexistente (grupo vacío)
+const std::uint32_t SIN_INDICE = 0xFFFFFFFFu;
+
+// Acumuladores de un grupo de personas
+struct AcumuladoGrupo {
+    std::uint32_t total;          // Personas en el grupo
+    std::uint32_t declarantes;    // Cuántas declaran renta
+    std::uint32_t masLongeva;     // Fecha de nacimiento más antigua
+    std::uint32_t maxPatrimonio;  // Mayor patrimonio
+    std::uint32_t minPatrimonio;  // Menor patrimonio
+    std::uint32_t maxDeuda;       // Mayor deuda
+
+    AcumuladoGrupo();
+};
+
+struct ReporteAnalitico {
+    AcumuladoGrupo pais;                        // Todo el dataset
+    std::vector<AcumuladoGrupo> porCiudad;      // Indexado por código de ciudad
+    AcumuladoGrupo porGrupoDIAN[3];             // Todas las personas por grupo A/B/C
+    std::uint32_t declarantesCalendario[3];     // Declarantes por grupo A/B/C
+    std::uint32_t primerDeclaranteCalendario[3]; // Ejemplo de cada grupo (o SIN_INDICE)
+};
+
+// Recorre el almacén una vez y devuelve el reporte completo
+ReporteAnalitico generarReporte(const PersonaStore& store);
+
+// --- Piezas del motor, para recorridos por bloques ---
+
+// Reporte sin filas, con un acumulador por ciudad registrada
+ReporteAnalitico reporteVacio();
+
+// Acumula las filas [inicio, fin) del almacén en 'reporte'
+void acumularRango(ReporteAnalitico& reporte, const PersonaStore& store,
+                   std::size_t inicio, std::size_t fin);
+
+// Mezcla en 'destino' un reporte de filas posteriores a las suyas; en empates
+// conserva los índices de 'destino' (las filas anteriores)
+void mezclarReporte(ReporteAnalitico& destino, const ReporteAnalitico& posterior,
+                    const PersonaStore& store);
+
+// --- Totales de dinero exactos ---
+// Se suman las columnas en centavos con enteros de 128 bits: sin redondeo ni
+// desbordamiento, y como la suma entera es asociativa el total paralelo es el
+// mismo bit a bit con cualquier número de hilos. El almacén debe tener las
+// columnas en centavos (PersonaStore::materializarCentavos); si no, se lanza
+// std::runtime_error.
+
+__extension__ typedef __int128 SumaCentavos; // Extensión de GCC/Clang
+
+struct TotalesDinero {
+    std::uint64_t personas;
+    SumaCentavos ingresos;
+    SumaCentavos patrimonio;
+    SumaCentavos deudas;
+
+    TotalesDinero();
+    SumaCentavos patrimonioNeto() const; // patrimonio - deudas
+};
+
+struct ReporteDinero {
+    TotalesDinero pais;                   // Todo el dataset
+    std::vector<TotalesDinero> porCiudad; // Indexado por código de ciudad
+};
+
+// Recorre el almacén una vez y devuelve los totales del país y por ciudad
+ReporteDinero generarReporteDinero(const PersonaStore& store);
+
+// Reporte sin filas, con un total por ciudad registrada
+ReporteDinero reporteDineroVacio();
+
+// Suma las filas [inicio, fin) del almacén a 'reporte'
+void acumularDineroRango(ReporteDinero& reporte, const PersonaStore& store,
+                         std::size_t inicio, std::size_t fin);
+
+// Suma 'otro' a 'destino' (el orden de mezcla no cambia el resultado)
+void mezclarReporteDinero(ReporteDinero& destino, const ReporteDinero& otro);
+
+// Promedio redondeado al centavo (mitades lejos de cero); 0 sin personas
+SumaCentavos promedioCentavos(SumaCentavos total, std::uint64_t personas);
+
+// Cantidad en centavos como texto en pesos: "[-]pesos.cc"
+std::string textoCentavos(SumaCentavos centavos);
+
+#endif // ANALITICA_H
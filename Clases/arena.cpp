@@ -0,0 +1,25 @@
+#include "arena.h"
+
+// Primer bloque de cada arena; los siguientes crecen en progresión geométrica
+static const std::size_t BLOQUE_INICIAL = 64 * 1024;
+
+ArenaPersonas::ArenaPersonas() {}
+
+void ArenaPersonas::preparar(std::size_t tramos) {
+    arenas.clear();
+    arenas.reserve(tramos);
+    for (std::size_t t = 0; t < tramos; ++t) {
+        arenas.push_back(std::unique_ptr<std::pmr::monotonic_buffer_resource>(
+            new std::pmr::monotonic_buffer_resource(BLOQUE_INICIAL)));
+    }
+}
+
+std::pmr::memory_resource* ArenaPersonas::tramo(std::size_t t) {
+    return arenas.at(t).get();
+}
+
+ArenaConsulta::ArenaConsulta() : arena(BLOQUE_INICIAL) {}
+
+std::pmr::memory_resource* ArenaConsulta::recurso() {
+    return &arena;
+}
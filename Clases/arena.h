@@ -0,0 +1,52 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// --- Arenas de memoria (std::pmr) ---
+// En una arena monótona reservar es avanzar un puntero y liberar no hace
+// nada; la memoria se devuelve en bloque al destruir la arena.
+// Los textos de Persona se crean en el recurso que se indique (ver persona.h);
+// quien use una arena debe destruirla después de las personas que la usan.
+
+// Memoria de los textos de un dataset generado: una arena por tramo de
+// generación, para que cada hilo del pool reserve sin cerrojos.
+// Debe destruirse DESPUÉS del vector de personas que la usa, y ninguna
+// persona movida (no copiada) desde ese vector debe sobrevivirla.
+class ArenaPersonas {
+public:
+    ArenaPersonas();
+
+    // Crea 'tramos' arenas vacías (descarta las anteriores). No es segura
+    // frente a otros hilos: se llama antes de repartir el trabajo.
+    void preparar(std::size_t tramos);
+    std::pmr::memory_resource* tramo(std::size_t t); // Arena del tramo t
+
+private:
+    ArenaPersonas(const ArenaPersonas&);            // No copiable
+    ArenaPersonas& operator=(const ArenaPersonas&);
+
+    std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource>> arenas;
+};
+
+// Arena de una consulta: los resultados la reciben de forma explícita (p. ej.
+// los agrupadores *Valor de Persona, con sus copias de personas incluidas),
+// así que deben declararse después de ella (se destruyen antes).
+// No es segura entre hilos: cada consulta usa la suya desde un solo hilo.
+class ArenaConsulta {
+public:
+    ArenaConsulta();
+
+    std::pmr::memory_resource* recurso(); // Recurso para los resultados
+
+private:
+    ArenaConsulta(const ArenaConsulta&);            // No copiable
+    ArenaConsulta& operator=(const ArenaConsulta&);
+
+    std::pmr::monotonic_buffer_resource arena;
+};
+
+#endif // ARENA_H
@@ -0,0 +1,271 @@
+// Banco de pruebas no interactivo: genera datasets de varios tamaños, ejecuta
+// cada consulta en sus formas por referencia, por valor, paralela y columnar,
+// y escribe mediana/p95 de tiempo y memoria por operación en un CSV.
+//
+// Uso: ./benchmark [--tamanos 10000,100000,1000000] [--calentamiento 1]
+//                  [--repeticiones 5] [--hilos 0] [--semilla 42]
+//                  [--salida benchmark.csv]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "analitica.h"
+#include "arena.h"
+#include "generador.h"
+#include "monitor.h"
+#include "paralelo.h"
+#include "persona.h"
+#include "persona_store.h"
+#include "rastreo.h"
+
+using namespace std;
+
+// Parámetros de la línea de comandos
+struct OpcionesBanco {
+    vector<size_t> tamanos;
+    int calentamiento;
+    int repeticiones;
+    unsigned hilos;
+    uint64_t semilla;
+    string salida;
+};
+
+// Una consulta medible: 'ejecutar' devuelve un valor que depende del resultado
+// para que el compilador no pueda descartar el trabajo
+struct OperacionBanco {
+    string nombre;
+    string forma; // REF, VALOR, PARALELO o COLUMNAR
+    function<uint64_t()> ejecutar;
+};
+
+// Resultado de todas las repeticiones de una operación
+struct MedicionBanco {
+    vector<double> tiempos;  // ms
+    vector<long> memorias;   // Variación de RSS en KB
+    // Por repetición, solo con RASTREO=1 (ver rastreo.h)
+    vector<uint64_t> asignaciones; // Llamadas a operator new
+    vector<uint64_t> bytes;        // Bytes asignados
+    vector<int64_t> picos;         // Pico del heap vivo sobre el inicio (bytes)
+};
+
+static vector<size_t> leerTamanos(const string& lista) {
+    vector<size_t> tamanos;
+    size_t inicio = 0;
+    while (inicio <= lista.size()) {
+        size_t coma = lista.find(',', inicio);
+        if (coma == string::npos) coma = lista.size();
+        const string parte = lista.substr(inicio, coma - inicio);
+        char* fin = nullptr;
+        const unsigned long long n = strtoull(parte.c_str(), &fin, 10);
+        if (parte.empty() || *fin != '\0' || n == 0) {
+            throw runtime_error("Tamaño inválido: '" + parte + "'");
+        }
+        tamanos.push_back(static_cast<size_t>(n));
+        inicio = coma + 1;
+    }
+    return tamanos;
+}
+
+static OpcionesBanco leerOpciones(int argc, char* argv[]) {
+    OpcionesBanco o;
+    o.tamanos = leerTamanos("10000,100000,1000000");
+    o.calentamiento = 1;
+    o.repeticiones = 5;
+    o.hilos = 0;
+    o.semilla = 42;
+    o.salida = "benchmark.csv";
+
+    for (int i = 1; i < argc; ++i) {
+        const string clave = argv[i];
+        if (i + 1 >= argc) throw runtime_error("Falta el valor de " + clave);
+        const string valor = argv[++i];
+        if (clave == "--tamanos") o.tamanos = leerTamanos(valor);
+        else if (clave == "--calentamiento") o.calentamiento = atoi(valor.c_str());
+        else if (clave == "--repeticiones") o.repeticiones = atoi(valor.c_str());
+        else if (clave == "--hilos") o.hilos = static_cast<unsigned>(atoi(valor.c_str()));
+        else if (clave == "--semilla") o.semilla = strtoull(valor.c_str(), nullptr, 10);
+        else if (clave == "--salida") o.salida = valor;
+        else throw runtime_error("Opción desconocida: " + clave);
+    }
+    if (o.calentamiento < 0 || o.repeticiones < 1) {
+        throw runtime_error("Se requiere calentamiento >= 0 y repeticiones >= 1");
+    }
+    return o;
+}
+
+// Suma de tamaños de los grupos (resultado observable de una agrupación)
+template <typename Mapa>
+static uint64_t totalAgrupado(const Mapa& grupos) {
+    uint64_t total = 0;
+    for (typename Mapa::const_iterator it = grupos.begin(); it != grupos.end(); ++it) {
+        total += it->second.size();
+    }
+    return total;
+}
+
+// Todas las consultas de las opciones 4 y 5 del menú sobre un mismo dataset
+static vector<OperacionBanco> operaciones(const vector<Persona>& personas, const PersonaStore& store,
+                                          PoolHilos& pool) {
+    vector<OperacionBanco> ops;
+
+    ops.push_back({"Más longeva", "REF", [&] {
+        Persona p; Persona::personaMaxLongeva(personas, p); return p.getId(); }});
+    ops.push_back({"Más longeva", "VALOR", [&] {
+        return Persona::personaMaxLongevaValor(personas).getId(); }});
+    ops.push_back({"Más longeva", "PARALELO", [&] {
+        Persona p; personaMaxLongevaParalelo(personas, p, pool); return p.getId(); }});
+
+    ops.push_back({"Mayor patrimonio", "REF", [&] {
+        Persona p; Persona::personaMaxPatrimonio(personas, p); return p.getId(); }});
+    ops.push_back({"Mayor patrimonio", "VALOR", [&] {
+        return Persona::personaMaxPatrimonioValor(personas).getId(); }});
+    ops.push_back({"Mayor patrimonio", "PARALELO", [&] {
+        Persona p; personaMaxPatrimonioParalelo(personas, p, pool); return p.getId(); }});
+
+    ops.push_back({"Menor patrimonio", "REF", [&] {
+        Persona p; Persona::personaMinPatrimonio(personas, p); return p.getId(); }});
+    ops.push_back({"Menor patrimonio", "VALOR", [&] {
+        return Persona::personaMinPatrimonioValor(personas).getId(); }});
+
+    ops.push_back({"Mayor deuda", "REF", [&] {
+        Persona p; Persona::personaMaxDeuda(personas, p); return p.getId(); }});
+    ops.push_back({"Mayor deuda", "VALOR", [&] {
+        return Persona::personaMaxDeudaValor(personas).getId(); }});
+
+    ops.push_back({"Agrupar por ciudad", "REF", [&] {
+        map<string, vector<Persona>> g; Persona::agruparPorCiudad(personas, g); return totalAgrupado(g); }});
+    ops.push_back({"Agrupar por ciudad", "VALOR", [&] {
+        ArenaConsulta arena; return totalAgrupado(Persona::agruparPorCiudadValor(personas, arena.recurso())); }});
+    ops.push_back({"Agrupar por ciudad", "PARALELO", [&] {
+        map<string, vector<uint32_t>> g; agruparPorCiudadParalelo(personas, g, pool); return totalAgrupado(g); }});
+
+    ops.push_back({"Agrupar por declaración", "REF", [&] {
+        map<string, vector<Persona>> g; Persona::agruparPorDeclaracion(personas, g); return totalAgrupado(g); }});
+    ops.push_back({"Agrupar por declaración", "VALOR", [&] {
+        ArenaConsulta arena; return totalAgrupado(Persona::agruparPorDeclaracionValor(personas, arena.recurso())); }});
+    ops.push_back({"Agrupar por declaración", "PARALELO", [&] {
+        map<string, vector<uint32_t>> g; agruparPorDeclaracionParalelo(personas, g, pool); return totalAgrupado(g); }});
+
+    ops.push_back({"Declarantes por ciudad", "REF", [&] {
+        map<string, vector<Persona>> g; Persona::declarantePorCiudad(personas, g); return totalAgrupado(g); }});
+    ops.push_back({"Declarantes por ciudad", "VALOR", [&] {
+        ArenaConsulta arena; return totalAgrupado(Persona::declarantePorCiudadValor(personas, arena.recurso())); }});
+    ops.push_back({"Declarantes por ciudad", "PARALELO", [&] {
+        map<string, vector<uint32_t>> g; declarantePorCiudadParalelo(personas, g, pool); return totalAgrupado(g); }});
+
+    ops.push_back({"Calendario", "REF", [&] {
+        return totalAgrupado(Persona::agruparDeclarantesPorCalendarioPtr(personas)); }});
+    ops.push_back({"Calendario", "VALOR", [&] {
+        ArenaConsulta arena;
+        Persona::CalendarioAgrupadito c = Persona::agruparDeclarantesPorCalendarioValor(personas, arena.recurso());
+        return static_cast<uint64_t>(c.conteo["Grupo A"] + c.conteo["Grupo B"] + c.conteo["Grupo C"]); }});
+
+    // Todos los agregados de la opción 4 en una sola pasada
+    ops.push_back({"Reporte analítico", "COLUMNAR", [&] {
+        return static_cast<uint64_t>(generarReporteParalelo(store, pool).pais.total); }});
+    return ops;
+}
+
+static MedicionBanco medir(const OperacionBanco& op, const OpcionesBanco& opciones, Monitor& monitor,
+                           uint64_t& control) {
+    MedicionBanco m;
+    for (int i = 0; i < opciones.calentamiento; ++i) control += op.ejecutar();
+
+    for (int i = 0; i < opciones.repeticiones; ++i) {
+        const long memoriaInicio = monitor.obtener_memoria();
+        MarcaRastreo marca = iniciarRastreo();
+        const chrono::high_resolution_clock::time_point inicio = chrono::high_resolution_clock::now();
+        control += op.ejecutar();
+        const chrono::duration<double, milli> duracion = chrono::high_resolution_clock::now() - inicio;
+        const ConteoAsignaciones conteo = medirRastreo(marca);
+        m.tiempos.push_back(duracion.count());
+        m.memorias.push_back(monitor.obtener_memoria() - memoriaInicio);
+        m.asignaciones.push_back(conteo.asignaciones);
+        m.bytes.push_back(conteo.bytes);
+        m.picos.push_back(conteo.picoVivo);
+    }
+    return m;
+}
+
+// Percentil por rango más cercano (p en (0, 100])
+template <typename T>
+static T percentil(vector<T> valores, double p) {
+    sort(valores.begin(), valores.end());
+    size_t rango = static_cast<size_t>(p / 100.0 * valores.size() + 0.999999);
+    if (rango == 0) rango = 1;
+    if (rango > valores.size()) rango = valores.size();
+    return valores[rango - 1];
+}
+
+int main(int argc, char* argv[]) {
+    OpcionesBanco opciones;
+    try {
+        opciones = leerOpciones(argc, argv);
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    ofstream csv(opciones.salida);
+    if (!csv) {
+        cerr << "Error al abrir archivo: " << opciones.salida << "\n";
+        return 1;
+    }
+    csv << "Filas,Operacion,Forma,Repeticiones,Mediana(ms),P95(ms),Min(ms),Max(ms),"
+           "MedianaMemoria(KB),P95Memoria(KB),MaxMemoria(KB),"
+           "MedianaAsignaciones,P95Asignaciones,MedianaBytesAsignados,P95BytesAsignados,"
+           "MedianaPicoHeap(B),P95PicoHeap(B)\n";
+
+    Monitor monitor;
+    PoolHilos pool(opciones.hilos);
+    uint64_t control = 0; // Resultado acumulado de todas las ejecuciones
+    cout << "Hilos: " << pool.getHilos() << ", calentamiento: " << opciones.calentamiento
+         << ", repeticiones: " << opciones.repeticiones << ", semilla: " << opciones.semilla << "\n";
+
+    for (size_t t = 0; t < opciones.tamanos.size(); ++t) {
+        const size_t n = opciones.tamanos[t];
+        const chrono::high_resolution_clock::time_point inicio = chrono::high_resolution_clock::now();
+        vector<Persona> personas = generarColeccionParalela(n, opciones.semilla, pool);
+        PersonaStore store(personas);
+        const chrono::duration<double, milli> generacion = chrono::high_resolution_clock::now() - inicio;
+        cout << "\n=== " << n << " filas (generadas en " << generacion.count() << " ms) ===\n";
+
+        const vector<OperacionBanco> ops = operaciones(personas, store, pool);
+        for (size_t i = 0; i < ops.size(); ++i) {
+            const MedicionBanco m = medir(ops[i], opciones, monitor, control);
+            const double mediana = percentil(m.tiempos, 50);
+            const double p95 = percentil(m.tiempos, 95);
+
+            csv << n << "," << ops[i].nombre << "," << ops[i].forma << "," << opciones.repeticiones << ","
+                << mediana << "," << p95 << ","
+                << *min_element(m.tiempos.begin(), m.tiempos.end()) << ","
+                << *max_element(m.tiempos.begin(), m.tiempos.end()) << ","
+                << percentil(m.memorias, 50) << "," << percentil(m.memorias, 95) << ","
+                << *max_element(m.memorias.begin(), m.memorias.end()) << ",";
+            if (rastreoActivo()) {
+                csv << percentil(m.asignaciones, 50) << "," << percentil(m.asignaciones, 95) << ","
+                    << percentil(m.bytes, 50) << "," << percentil(m.bytes, 95) << ","
+                    << percentil(m.picos, 50) << "," << percentil(m.picos, 95);
+            } else {
+                csv << ",,,,,";
+            }
+            csv << "\n";
+            csv.flush(); // Las mediciones largas quedan guardadas aunque se interrumpa
+
+            cout << ops[i].nombre << " [" << ops[i].forma << "]: mediana " << mediana
+                 << " ms, p95 " << p95 << " ms\n";
+        }
+    }
+
+    cout << "\nResultados en " << opciones.salida << " (control " << control << ")\n";
+    return 0;
+}
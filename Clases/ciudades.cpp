@@ -0,0 +1,76 @@
+#include "ciudades.h"
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+// Principales ciudades colombianas (su posición es su código)
+static const char* const ciudadesColombia[] = {
+    "Bogotá", "Medellín", "Cali", "Barranquilla", "Cartagena", "Bucaramanga", "Pereira", "Santa Marta", "Cúcuta", "Ibagué",
+    "Manizales", "Pasto", "Neiva", "Villavicencio", "Armenia", "Sincelejo", "Valledupar", "Montería", "Popayán", "Tunja"
+};
+
+static const std::size_t TOTAL_COLOMBIA = sizeof(ciudadesColombia) / sizeof(ciudadesColombia[0]);
+
+// Códigos posibles: todo el rango de CodigoCiudad
+static const std::size_t CAPACIDAD = static_cast<std::size_t>(std::numeric_limits<CodigoCiudad>::max()) + 1;
+
+// Estado del diccionario. std::deque mantiene estables las referencias a los
+// nombres aunque se registren ciudades nuevas. Las lecturas por código no
+// toman el cerrojo: 'porCodigo' tiene capacidad fija (nunca se reubica) y
+// cada entrada se escribe antes de publicar el nuevo 'total'.
+struct Diccionario {
+    std::deque<std::string> nombres;                       // código -> nombre
+    std::unordered_map<std::string, CodigoCiudad> codigos; // nombre -> código
+    std::unique_ptr<const std::string*[]> porCodigo;      // código -> nombre, sin cerrojo
+    std::atomic<std::size_t> total;                        // Códigos publicados
+    std::mutex cerrojo; // La importación CSV registra ciudades desde varios hilos
+
+    Diccionario() : porCodigo(new const std::string*[CAPACIDAD]), total(0) {
+        for (std::size_t i = 0; i < TOTAL_COLOMBIA; ++i) registrar(ciudadesColombia[i]);
+    }
+
+    // Agrega un nombre nuevo (con el cerrojo tomado, salvo en el constructor)
+    CodigoCiudad registrar(const std::string& nombre) {
+        const std::size_t codigo = nombres.size();
+        if (codigo >= CAPACIDAD) throw std::length_error("Diccionario de ciudades lleno");
+        nombres.push_back(nombre);
+        codigos[nombre] = static_cast<CodigoCiudad>(codigo);
+        porCodigo[codigo] = &nombres.back();
+        total.store(codigo + 1, std::memory_order_release);
+        return static_cast<CodigoCiudad>(codigo);
+    }
+};
+
+// Inicialización en el primer uso (evita depender del orden entre unidades)
+static Diccionario& diccionario() {
+    static Diccionario dic;
+    return dic;
+}
+
+CodigoCiudad codigoCiudad(const std::string& nombre) {
+    Diccionario& dic = diccionario();
+    std::lock_guard<std::mutex> guarda(dic.cerrojo);
+
+    std::unordered_map<std::string, CodigoCiudad>::const_iterator it = dic.codigos.find(nombre);
+    if (it != dic.codigos.end()) return it->second;
+    return dic.registrar(nombre);
+}
+
+// Sin cerrojo: la exportación CSV y los listados la llaman una vez por fila
+const std::string& nombreCiudad(CodigoCiudad codigo) {
+    const Diccionario& dic = diccionario();
+    if (codigo >= dic.total.load(std::memory_order_acquire)) {
+        throw std::out_of_range("Código de ciudad no registrado");
+    }
+    return *dic.porCodigo[codigo];
+}
+
+std::size_t totalCiudades() {
+    return diccionario().total.load(std::memory_order_acquire);
+}
+
+std::size_t totalCiudadesColombia() { return TOTAL_COLOMBIA; }
@@ -0,0 +1,28 @@
+#ifndef CIUDADES_H
+#define CIUDADES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// --- Diccionario global de ciudades ---
+// Cada persona guarda un código compacto en lugar del nombre de la ciudad;
+// el nombre solo se resuelve al mostrar. Los códigos 0..totalCiudadesColombia()-1
+// corresponden a la tabla fija de ciudades colombianas usada por el generador.
+// Todas las funciones pueden llamarse desde varios hilos a la vez.
+
+typedef std::uint16_t CodigoCiudad;
+
+// Devuelve el código de una ciudad, registrándola si aún no existe
+CodigoCiudad codigoCiudad(const std::string& nombre);
+
+// Nombre de la ciudad asociada a un código (referencia estable)
+const std::string& nombreCiudad(CodigoCiudad codigo);
+
+// Número de ciudades registradas (códigos válidos: 0..totalCiudades()-1)
+std::size_t totalCiudades();
+
+// Número de ciudades de la tabla fija colombiana
+std::size_t totalCiudadesColombia();
+
+#endif // CIUDADES_H
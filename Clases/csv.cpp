@@ -0,0 +1,369 @@
+#include "csv.h"
+#include <algorithm>
+#include <charconv>   // from_chars, to_chars
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+#include "ciudades.h"
+#include "paralelo.h"
+#include "persona_store.h"
+
+static const char ENCABEZADO[] =
+    "id,nombre,apellido,ciudad,fecha_nacimiento,ingresos,patrimonio,deudas,declarante";
+static const int TOTAL_CAMPOS = 9;
+
+// Filas que formatea cada tarea al exportar
+static const std::size_t FILAS_POR_BLOQUE = 65536;
+// Bytes mínimos por rango al importar (rangos más chicos no compensan la tarea)
+static const std::size_t BYTES_MINIMOS_POR_RANGO = 1 << 20;
+
+// --- Exportación ---
+
+template <typename T>
+static void anexarNumero(std::string& salida, T valor) {
+    char buffer[32];
+    std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), valor);
+    salida.append(buffer, r.ptr);
+}
+
+static void anexarTexto(std::string& salida, std::string_view texto) {
+    if (texto.find_first_of(",\"\r\n") == std::string_view::npos) {
+        salida += texto;
+        return;
+    }
+    if (texto.find_first_of("\r\n") != std::string_view::npos) {
+        throw std::invalid_argument("Salto de línea no admitido en CSV: " + std::string(texto));
+    }
+    salida += '"';
+    for (char c : texto) {
+        if (c == '"') salida += '"';
+        salida += c;
+    }
+    salida += '"';
+}
+
+static void anexarDosDigitos(std::string& salida, int valor) {
+    salida += static_cast<char>('0' + valor / 10);
+    salida += static_cast<char>('0' + valor % 10);
+}
+
+// DD/MM/AAAA sin pasar por un std::string intermedio
+static void anexarFecha(std::string& salida, std::int32_t fecha) {
+    const int anio = fecha / 10000;
+    if (fecha < 0 || anio > 9999) {
+        salida += Persona::formatearFecha(fecha);
+        return;
+    }
+    anexarDosDigitos(salida, fecha % 100);
+    salida += '/';
+    anexarDosDigitos(salida, fecha / 100 % 100);
+    salida += '/';
+    anexarDosDigitos(salida, anio / 100);
+    anexarDosDigitos(salida, anio % 100);
+}
+
+static void formatearBloque(std::string& salida, const std::vector<Persona>& personas,
+                            std::size_t inicio, std::size_t fin) {
+    salida.clear();
+    for (std::size_t i = inicio; i < fin; ++i) {
+        const Persona& p = personas[i];
+        anexarNumero(salida, p.getId());
+        salida += ',';
+        anexarTexto(salida, p.getNombre());
+        salida += ',';
+        anexarTexto(salida, p.getApellido());
+        salida += ',';
+        anexarTexto(salida, nombreCiudad(p.getCodigoCiudad()));
+        salida += ',';
+        anexarFecha(salida, p.getFechaEmpaquetada());
+        salida += ',';
+        anexarNumero(salida, p.getIngresosAnuales());
+        salida += ',';
+        anexarNumero(salida, p.getPatrimonio());
+        salida += ',';
+        anexarNumero(salida, p.getDeudas());
+        salida += ',';
+        salida += p.getDeclaranteRenta() ? '1' : '0';
+        salida += '\n';
+    }
+}
+
+EscritorCSV::EscritorCSV(const std::string& ruta, PoolHilos& pool)
+    : archivo(std::fopen(ruta.c_str(), "wb")), ruta(ruta), pool(pool), textos(pool.getHilos()) {
+    if (!archivo) throw std::runtime_error("No se pudo abrir " + ruta);
+    if (std::fputs(ENCABEZADO, archivo) == EOF || std::fputc('\n', archivo) == EOF) {
+        std::fclose(archivo);
+        throw std::runtime_error("Error escribiendo en " + ruta);
+    }
+}
+
+EscritorCSV::~EscritorCSV() {
+    if (archivo) std::fclose(archivo);
+}
+
+void EscritorCSV::escribir(const std::vector<Persona>& personas) {
+    if (!archivo) throw std::runtime_error("Archivo ya cerrado: " + ruta);
+
+    // Cada ronda formatea en paralelo un bloque por hilo y luego los escribe
+    // en orden; la memoria usada es la de una ronda, no la del archivo completo
+    const std::size_t bloques = (personas.size() + FILAS_POR_BLOQUE - 1) / FILAS_POR_BLOQUE;
+    for (std::size_t primero = 0; primero < bloques; primero += textos.size()) {
+        const std::size_t enRonda = std::min(textos.size(), bloques - primero);
+        pool.paraCada(enRonda, [&](std::size_t t) {
+            const std::size_t inicio = (primero + t) * FILAS_POR_BLOQUE;
+            formatearBloque(textos[t], personas, inicio,
+                            std::min(personas.size(), inicio + FILAS_POR_BLOQUE));
+        });
+        for (std::size_t t = 0; t < enRonda; ++t) {
+            if (std::fwrite(textos[t].data(), 1, textos[t].size(), archivo) != textos[t].size()) {
+                throw std::runtime_error("Error escribiendo en " + ruta);
+            }
+        }
+    }
+}
+
+void EscritorCSV::cerrar() {
+    if (!archivo) return;
+    const bool error = std::fclose(archivo) != 0;
+    archivo = nullptr;
+    if (error) throw std::runtime_error("Error escribiendo en " + ruta);
+}
+
+void exportarCSV(const std::string& ruta, const std::vector<Persona>& personas, PoolHilos& pool) {
+    EscritorCSV escritor(ruta, pool);
+    escritor.escribir(personas);
+    escritor.cerrar();
+}
+
+// --- Importación ---
+
+// Archivo mapeado en memoria de solo lectura
+class ArchivoMapeado {
+public:
+    explicit ArchivoMapeado(const std::string& ruta) : datos(nullptr), tamano(0) {
+        const int fd = open(ruta.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("No se pudo abrir " + ruta);
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw std::runtime_error("No se pudo leer " + ruta);
+        }
+        tamano = static_cast<std::size_t>(info.st_size);
+        if (tamano > 0) {
+            void* mapa = mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapa == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("No se pudo mapear " + ruta);
+            }
+            madvise(mapa, tamano, MADV_SEQUENTIAL); // Lectura de principio a fin
+            datos = static_cast<const char*>(mapa);
+        }
+        close(fd);
+    }
+    ~ArchivoMapeado() {
+        if (datos) munmap(const_cast<char*>(datos), tamano);
+    }
+
+    const char* datos;
+    std::size_t tamano;
+
+private:
+    ArchivoMapeado(const ArchivoMapeado&);
+    ArchivoMapeado& operator=(const ArchivoMapeado&);
+};
+
+// Error de análisis con la posición del registro que lo produjo
+struct ErrorCSV {
+    const char* posicion;
+    std::string motivo;
+};
+
+// Separa el siguiente campo de [p, fin). Los campos entre comillas se
+// desescapan en 'buffer'; el resto se devuelve sin copiar. 'hayMas' indica
+// si el campo terminó en coma (le sigue otro).
+static std::string_view siguienteCampo(const char*& p, const char* fin, std::string& buffer,
+                                       const char* linea, bool& hayMas) {
+    if (p < fin && *p == '"') {
+        buffer.clear();
+        ++p;
+        while (true) {
+            if (p >= fin) throw ErrorCSV{linea, "comillas sin cerrar"};
+            if (*p == '"') {
+                if (p + 1 < fin && p[1] == '"') {
+                    buffer += '"';
+                    p += 2;
+                    continue;
+                }
+                ++p;
+                break;
+            }
+            buffer += *p++;
+        }
+        if (p < fin && *p != ',') throw ErrorCSV{linea, "texto después de comillas"};
+        hayMas = p < fin;
+        if (hayMas) ++p;
+        return std::string_view(buffer);
+    }
+    const char* inicio = p;
+    const char* coma = static_cast<const char*>(std::memchr(p, ',', static_cast<std::size_t>(fin - p)));
+    const char* finCampo = coma ? coma : fin;
+    hayMas = coma != nullptr;
+    p = coma ? coma + 1 : fin;
+    return std::string_view(inicio, static_cast<std::size_t>(finCampo - inicio));
+}
+
+template <typename T>
+static T leerNumero(std::string_view campo, const char* linea, const char* nombre) {
+    T valor{};
+    const char* fin = campo.data() + campo.size();
+    std::from_chars_result r = std::from_chars(campo.data(), fin, valor);
+    if (r.ec != std::errc() || r.ptr != fin) {
+        throw ErrorCSV{linea, std::string(nombre) + " inválido: " + std::string(campo)};
+    }
+    return valor;
+}
+
+// Cantidad en pesos; se rechaza al importar si no cabe en centavos de 64 bits,
+// así las columnas en centavos del almacén siempre se pueden materializar
+static double leerDinero(std::string_view campo, const char* linea, const char* nombre) {
+    const double valor = leerNumero<double>(campo, linea, nombre);
+    try {
+        aCentavos(valor);
+    } catch (const std::out_of_range&) {
+        throw ErrorCSV{linea, std::string(nombre) + " fuera de rango: " + std::string(campo)};
+    }
+    return valor;
+}
+
+// DD/MM/AAAA o AAAA-MM-DD, validada por Persona::empaquetarFecha (año de
+// 4 dígitos, mes 1-12, día existente en el mes)
+static std::int32_t leerFecha(std::string_view campo, const char* linea) {
+    try {
+        return Persona::empaquetarFecha(campo);
+    } catch (const std::invalid_argument&) {
+        throw ErrorCSV{linea, "fecha inválida: " + std::string(campo)};
+    }
+}
+
+static bool leerDeclarante(std::string_view campo, const char* linea) {
+    if (campo == "1" || campo == "true") return true;
+    if (campo == "0" || campo == "false") return false;
+    throw ErrorCSV{linea, "declarante inválido: " + std::string(campo)};
+}
+
+// Analiza las líneas completas de [inicio, fin) y las añade a 'personas'
+static void analizarRango(const char* inicio, const char* fin, std::vector<Persona>& personas) {
+    // Caché local de ciudades: evita el cerrojo del diccionario en cada fila
+    std::map<std::string, CodigoCiudad, std::less<>> ciudades;
+    std::string buffers[TOTAL_CAMPOS];
+    std::string_view campos[TOTAL_CAMPOS];
+
+    // Estimación de ~80 bytes por registro para reservar una sola vez
+    personas.reserve(static_cast<std::size_t>(fin - inicio) / 80 + 1);
+
+    const char* p = inicio;
+    while (p < fin) {
+        const char* linea = p;
+        const char* salto = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(fin - p)));
+        const char* finLinea = salto ? salto : fin;
+        p = salto ? salto + 1 : fin;
+        if (finLinea > linea && finLinea[-1] == '\r') --finLinea;
+        if (finLinea == linea) continue; // Línea vacía
+
+        const char* q = linea;
+        bool hayMas = true;
+        for (int k = 0; k < TOTAL_CAMPOS; ++k) {
+            if (!hayMas) throw ErrorCSV{linea, "se esperaban " + std::to_string(TOTAL_CAMPOS) + " campos"};
+            campos[k] = siguienteCampo(q, finLinea, buffers[k], linea, hayMas);
+        }
+        if (hayMas) throw ErrorCSV{linea, "sobran campos"};
+
+        std::map<std::string, CodigoCiudad, std::less<>>::const_iterator c = ciudades.find(campos[3]);
+        if (c == ciudades.end()) {
+            const std::string nombre(campos[3]);
+            c = ciudades.emplace(nombre, codigoCiudad(nombre)).first;
+        }
+
+        personas.push_back(Persona(campos[1], campos[2],
+                                   leerNumero<std::uint64_t>(campos[0], linea, "id"),
+                                   c->second,
+                                   leerFecha(campos[4], linea),
+                                   leerDinero(campos[5], linea, "ingresos"),
+                                   leerDinero(campos[6], linea, "patrimonio"),
+                                   leerDinero(campos[7], linea, "deudas"),
+                                   leerDeclarante(campos[8], linea)));
+    }
+}
+
+// Avanza hasta el inicio de la siguiente línea
+static const char* siguienteLinea(const char* p, const char* fin) {
+    const char* salto = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(fin - p)));
+    return salto ? salto + 1 : fin;
+}
+
+std::vector<Persona> importarCSV(const std::string& ruta, PoolHilos& pool) {
+    ArchivoMapeado archivo(ruta);
+    const char* datos = archivo.datos;
+    const char* fin = datos + archivo.tamano;
+    if (archivo.tamano == 0) throw std::runtime_error("Archivo CSV vacío: " + ruta);
+
+    // Encabezado (se tolera la marca BOM de UTF-8)
+    const char* cuerpo = siguienteLinea(datos, fin);
+    std::string_view encabezado(datos, static_cast<std::size_t>(cuerpo - datos));
+    if (encabezado.substr(0, 3) == "\xEF\xBB\xBF") encabezado.remove_prefix(3);
+    while (!encabezado.empty() && (encabezado.back() == '\n' || encabezado.back() == '\r')) {
+        encabezado.remove_suffix(1);
+    }
+    if (encabezado != ENCABEZADO) {
+        throw std::runtime_error("Encabezado CSV inesperado en " + ruta + "; se espera: " + ENCABEZADO);
+    }
+
+    // Rangos de bytes ajustados al inicio de línea
+    const std::size_t bytes = static_cast<std::size_t>(fin - cuerpo);
+    const std::size_t rangos = std::max<std::size_t>(1, std::min<std::size_t>(
+        static_cast<std::size_t>(pool.getHilos()) * 4, bytes / BYTES_MINIMOS_POR_RANGO));
+    std::vector<const char*> limites(rangos + 1);
+    limites[0] = cuerpo;
+    limites[rangos] = fin;
+    for (std::size_t r = 1; r < rangos; ++r) {
+        limites[r] = std::max(limites[r - 1], siguienteLinea(cuerpo + bytes * r / rangos - 1, fin));
+    }
+
+    std::vector<std::vector<Persona>> partes(rangos);
+    std::vector<ErrorCSV> errores(rangos, ErrorCSV{nullptr, std::string()});
+    pool.paraCada(rangos, [&](std::size_t r) {
+        try {
+            analizarRango(limites[r], limites[r + 1], partes[r]);
+        } catch (const ErrorCSV& e) {
+            errores[r] = e;
+        } catch (const std::exception& e) {
+            errores[r] = ErrorCSV{limites[r], e.what()};
+        }
+    });
+
+    // El primer error en orden de archivo, con su número de línea
+    for (std::size_t r = 0; r < rangos; ++r) {
+        if (errores[r].posicion) {
+            const long linea = 1 + std::count(datos, errores[r].posicion, '\n');
+            throw std::runtime_error("CSV inválido en línea " + std::to_string(linea) + ": " + errores[r].motivo);
+        }
+    }
+
+    std::size_t total = 0;
+    for (std::size_t r = 0; r < rangos; ++r) total += partes[r].size();
+    std::vector<Persona> personas;
+    personas.reserve(total);
+    for (std::size_t r = 0; r < rangos; ++r) {
+        std::move(partes[r].begin(), partes[r].end(), std::back_inserter(personas));
+        std::vector<Persona>().swap(partes[r]);
+    }
+    return personas;
+}
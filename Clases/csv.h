@@ -0,0 +1,52 @@
+#ifndef CSV_H
+#define CSV_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "persona.h"
+
+class PoolHilos;
+
+// --- Importación y exportación de personas en CSV ---
+// Columnas (con encabezado):
+//   id,nombre,apellido,ciudad,fecha_nacimiento,ingresos,patrimonio,deudas,declarante
+// La fecha se escribe DD/MM/AAAA y se acepta también AAAA-MM-DD; declarante
+// es 1 o 0. Los números usan la representación más corta que se relee exacta.
+// Los textos con comas o comillas van entre comillas ("" escapa una comilla);
+// no se admiten saltos de línea dentro de un campo, así cada línea es un registro.
+
+// Escribe un CSV por partes: el encabezado al abrir y luego las filas de
+// cada llamada a escribir(), en orden. Sirve para datasets que no caben en
+// memoria (ver SumideroArchivo). Lanza std::runtime_error si falla.
+class EscritorCSV {
+public:
+    EscritorCSV(const std::string& ruta, PoolHilos& pool);
+    ~EscritorCSV();
+
+    // Añade 'personas' al final; el formateo se reparte entre los hilos del pool
+    void escribir(const std::vector<Persona>& personas);
+    void cerrar(); // Vacía y cierra el archivo (el destructor cierra sin reportar errores)
+
+private:
+    EscritorCSV(const EscritorCSV&);            // No copiable
+    EscritorCSV& operator=(const EscritorCSV&);
+
+    std::FILE* archivo;
+    std::string ruta;
+    PoolHilos& pool;
+    std::vector<std::string> textos; // Un bloque formateado por hilo
+};
+
+// Escribe 'personas' en 'ruta'. El formateo se reparte entre los hilos del
+// pool por bloques y se escribe en orden. Lanza std::runtime_error si falla.
+void exportarCSV(const std::string& ruta, const std::vector<Persona>& personas, PoolHilos& pool);
+
+// Lee 'ruta' con mmap y analiza rangos de líneas en paralelo. Conserva el
+// orden del archivo. Lanza std::runtime_error con el número de línea del
+// primer registro inválido, incluidas las fechas inexistentes y las
+// cantidades que no caben en centavos de 64 bits (ver aCentavos).
+std::vector<Persona> importarCSV(const std::string& ruta, PoolHilos& pool);
+
+#endif // CSV_H
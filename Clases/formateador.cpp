@@ -0,0 +1,111 @@
+#include "formateador.h"
+#include <cerrno>
+#include <charconv>   // to_chars
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>   // write
+#include "persona.h"
+
+// Mayor texto que produce un solo número (double fijo con 2 decimales < 330 bytes)
+static const std::size_t MAX_NUMERO = 512;
+
+FormateadorBuffer::FormateadorBuffer(int fd, std::size_t capacidad)
+    : fd(fd), buffer(nullptr), capacidad(capacidad < MAX_NUMERO ? MAX_NUMERO : capacidad), usado(0) {
+    buffer = new char[this->capacidad];
+}
+
+FormateadorBuffer::~FormateadorBuffer() {
+    try {
+        volcar();
+    } catch (...) {
+        // Un destructor no debe lanzar; el error ya no tiene a quién reportarse
+    }
+    delete[] buffer;
+}
+
+char* FormateadorBuffer::reservar(std::size_t n) {
+    if (capacidad - usado < n) volcar();
+    return buffer + usado;
+}
+
+FormateadorBuffer& FormateadorBuffer::texto(const char* s, std::size_t n) {
+    // Textos más grandes que el búfer se escriben por partes
+    while (n > 0) {
+        if (usado == capacidad) volcar();
+        const std::size_t parte = n < capacidad - usado ? n : capacidad - usado;
+        std::memcpy(buffer + usado, s, parte);
+        usado += parte;
+        s += parte;
+        n -= parte;
+    }
+    return *this;
+}
+
+FormateadorBuffer& FormateadorBuffer::texto(const char* s) { return texto(s, std::strlen(s)); }
+FormateadorBuffer& FormateadorBuffer::texto(const std::string& s) { return texto(s.data(), s.size()); }
+
+FormateadorBuffer& FormateadorBuffer::caracter(char c) {
+    *reservar(1) = c;
+    ++usado;
+    return *this;
+}
+
+FormateadorBuffer& FormateadorBuffer::entero(std::uint64_t valor) {
+    // Dígitos de derecha a izquierda en un arreglo local
+    char digitos[20];
+    int n = 0;
+    do {
+        digitos[19 - n++] = static_cast<char>('0' + valor % 10);
+        valor /= 10;
+    } while (valor != 0);
+    return texto(digitos + 20 - n, static_cast<std::size_t>(n));
+}
+
+FormateadorBuffer& FormateadorBuffer::decimal(double valor, int decimales) {
+    char* destino = reservar(MAX_NUMERO);
+    std::to_chars_result r = std::to_chars(destino, destino + MAX_NUMERO, valor,
+                                           std::chars_format::fixed, decimales);
+    if (r.ec != std::errc()) throw std::runtime_error("No se pudo formatear un decimal");
+    usado += static_cast<std::size_t>(r.ptr - destino);
+    return *this;
+}
+
+FormateadorBuffer& FormateadorBuffer::fecha(std::int32_t fecha) {
+    const int anio = fecha / 10000;
+    if (fecha < 0 || anio > 9999) return texto(Persona::formatearFecha(fecha));
+
+    const int dia = fecha % 100;
+    const int mes = fecha / 100 % 100;
+    char* d = reservar(10);
+    d[0] = static_cast<char>('0' + dia / 10);
+    d[1] = static_cast<char>('0' + dia % 10);
+    d[2] = '/';
+    d[3] = static_cast<char>('0' + mes / 10);
+    d[4] = static_cast<char>('0' + mes % 10);
+    d[5] = '/';
+    d[6] = static_cast<char>('0' + anio / 1000);
+    d[7] = static_cast<char>('0' + anio / 100 % 10);
+    d[8] = static_cast<char>('0' + anio / 10 % 10);
+    d[9] = static_cast<char>('0' + anio % 10);
+    usado += 10;
+    return *this;
+}
+
+void FormateadorBuffer::volcar() {
+    std::cout.flush();
+    std::fflush(stdout);
+
+    std::size_t enviado = 0;
+    while (enviado < usado) {
+        const ssize_t n = write(fd, buffer + enviado, usado - enviado);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            usado = 0;
+            throw std::runtime_error(std::string("Error escribiendo la salida: ") + std::strerror(errno));
+        }
+        enviado += static_cast<std::size_t>(n);
+    }
+    usado = 0;
+}
@@ -0,0 +1,42 @@
+#ifndef FORMATEADOR_H
+#define FORMATEADOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Formateador de salida masiva: acumula texto en un búfer propio y lo envía
+// al descriptor con pocas llamadas grandes a write(), sin pasar por iostream.
+// Los enteros y fechas se formatean a mano; los decimales con std::to_chars
+// (exacto, sin locale), con el mismo redondeo que std::fixed.
+class FormateadorBuffer {
+public:
+    // 'fd' = descriptor de salida (1 = stdout); 'capacidad' = bytes del búfer
+    explicit FormateadorBuffer(int fd = 1, std::size_t capacidad = 1 << 20);
+    ~FormateadorBuffer(); // Vuelca lo pendiente (ignora errores)
+
+    FormateadorBuffer& texto(const char* s, std::size_t n);
+    FormateadorBuffer& texto(const char* s);
+    FormateadorBuffer& texto(const std::string& s);
+    FormateadorBuffer& caracter(char c);
+    FormateadorBuffer& entero(std::uint64_t valor);
+    FormateadorBuffer& decimal(double valor, int decimales = 2); // Notación fija
+    FormateadorBuffer& fecha(std::int32_t fecha);               // AAAAMMDD -> DD/MM/AAAA
+
+    // Escribe el búfer en el descriptor. Antes vacía std::cout y stdout para
+    // respetar el orden con la salida previa. Lanza std::runtime_error si falla.
+    void volcar();
+
+private:
+    FormateadorBuffer(const FormateadorBuffer&);            // No copiable
+    FormateadorBuffer& operator=(const FormateadorBuffer&);
+
+    char* reservar(std::size_t n); // Espacio contiguo para n bytes
+
+    int fd;
+    char* buffer;
+    std::size_t capacidad;
+    std::size_t usado;
+};
+
+#endif // FORMATEADOR_H
@@ -4,6 +4,10 @@
 #include <random>    // Generadores aleatorios modernos
 #include <vector>
 #include <algorithm> // Para find_if
+#include <cstring>   // memcpy
+#include <new>       // new de ubicación
+#include <stdexcept> // std::invalid_argument, std::length_error
+#include <utility>   // std::move
 
 // --- Bases de datos para generación realista ---
 
@@ -27,15 +31,9 @@ const std::vector<std::string> apellidos = {
     "Díaz", "Vargas", "Castro", "Ruiz", "Álvarez", "Romero", "Suárez", "Rojas", "Moreno", "Muñoz", "Valencia",
 };
 
-// Principales ciudades colombianas
-const std::vector<std::string> ciudadesColombia = {
-    "Bogotá", "Medellín", "Cali", "Barranquilla", "Cartagena", "Bucaramanga", "Pereira", "Santa Marta", "Cúcuta", "Ibagué",
-    "Manizales", "Pasto", "Neiva", "Villavicencio", "Armenia", "Sincelejo", "Valledupar", "Montería", "Popayán", "Tunja"
-};
-
 // Implementación de funciones generadoras
 
-std::string generarFechaNacimiento() {
+std::int32_t generarFechaNacimiento() {
     // Genera día aleatorio (1-28 para simplificar)
     int dia = 1 + rand() % 28;
     // Mes aleatorio (1-12)
@@ -43,13 +41,13 @@ std::string generarFechaNacimiento() {
     // Año entre 1960-2010
     int anio = 1960 + rand() % 50;
     
-    // Convierte a string en formato DD/MM/AAAA
-    return std::to_string(dia) + "/" + std::to_string(mes) + "/" + std::to_string(anio);
+    // Empaqueta como entero AAAAMMDD (sin cadenas intermedias)
+    return anio * 10000 + mes * 100 + dia;
 }
 
-std::string generarID() {
-    static long contador = 1000000000; // ID inicial
-    return std::to_string(contador++); // Incrementa después de usar
+std::uint64_t generarID() {
+    static std::uint64_t contador = 1000000000; // ID inicial
+    return contador++; // Incrementa después de usar
 }
 
 double randomDouble(double min, double max) {
@@ -60,25 +58,40 @@ double randomDouble(double min, double max) {
     return distribution(generator);
 }
 
+// Une dos apellidos en 'buffer' sin reservar memoria; Persona copia el
+// resultado directamente a su texto, en el recurso que reciba
+static const std::size_t MAX_APELLIDO = 128;
+
+static std::string_view componerApellido(const std::string& primero, const std::string& segundo,
+                                         char (&buffer)[MAX_APELLIDO]) {
+    const std::size_t total = primero.size() + 1 + segundo.size();
+    if (total > MAX_APELLIDO) throw std::length_error("Apellido demasiado largo");
+    std::memcpy(buffer, primero.data(), primero.size());
+    buffer[primero.size()] = ' ';
+    std::memcpy(buffer + primero.size() + 1, segundo.data(), segundo.size());
+    return std::string_view(buffer, total);
+}
+
 Persona generarPersona() {
     // Decide aleatoriamente si es hombre o mujer
     bool esHombre = rand() % 2;
     
-    // Selecciona nombre según género
-    std::string nombre = esHombre ? 
+    // Selecciona nombre según género (referencia a la tabla; se copia una vez)
+    const std::string& nombre = esHombre ? 
         nombresMasculinos[rand() % nombresMasculinos.size()] :
         nombresFemeninos[rand() % nombresFemeninos.size()];
     
     // Combina dos apellidos aleatorios
-    std::string apellido = apellidos[rand() % apellidos.size()] + " " + 
-                           apellidos[rand() % apellidos.size()];
+    char buffer[MAX_APELLIDO];
+    std::string_view apellido = componerApellido(apellidos[rand() % apellidos.size()],
+                                                 apellidos[rand() % apellidos.size()], buffer);
     
     // Genera identificadores únicos
-    std::string id = generarID();
-    // Ciudad aleatoria de Colombia
-    std::string ciudad = ciudadesColombia[rand() % ciudadesColombia.size()];
+    std::uint64_t id = generarID();
+    // Ciudad aleatoria de Colombia (código en el diccionario de ciudades.h)
+    CodigoCiudad ciudad = static_cast<CodigoCiudad>(rand() % totalCiudadesColombia());
     // Fecha aleatoria
-    std::string fecha = generarFechaNacimiento();
+    std::int32_t fecha = generarFechaNacimiento();
     
     // --- Generación de datos económicos realistas ---
     // Ingresos entre 10 millones y 500 millones COP
@@ -107,12 +120,170 @@ std::vector<Persona> generarColeccion(int n) {
     return personas;
 }
 
-const Persona* buscarPorID(const std::vector<Persona>& personas, const std::string& id) {
-    // Búsqueda lineal por ID (solución simple para colecciones medianas)
+// Índice del último dataset indexado
+static IndiceID indiceActivo;
+
+const IndiceID& indexarPorID(const std::vector<Persona>& personas) {
+    indiceActivo.construir(personas);
+    return indiceActivo;
+}
+
+// --- Generación paralela determinista ---
+
+static std::uint64_t splitmix64(std::uint64_t& x) {
+    std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static std::uint64_t rotarIzquierda(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+GeneradorAleatorio::GeneradorAleatorio(std::uint64_t semilla, std::uint64_t flujo) {
+    // Mezcla semilla y flujo para que flujos vecinos no se correlacionen
+    std::uint64_t x = semilla ^ (flujo * 0xd1b54a32d192ed03ULL);
+    for (int i = 0; i < 4; ++i) estado[i] = splitmix64(x);
+}
+
+std::uint64_t GeneradorAleatorio::siguiente() {
+    const std::uint64_t resultado = rotarIzquierda(estado[1] * 5, 7) * 9;
+    const std::uint64_t t = estado[1] << 17;
+    estado[2] ^= estado[0];
+    estado[3] ^= estado[1];
+    estado[1] ^= estado[2];
+    estado[0] ^= estado[3];
+    estado[2] ^= t;
+    estado[3] = rotarIzquierda(estado[3], 45);
+    return resultado;
+}
+
+std::uint32_t GeneradorAleatorio::enteroHasta(std::uint32_t limite) {
+    // Multiplicación de 32x32 bits: reparto uniforme sin divisiones
+    return static_cast<std::uint32_t>(((siguiente() >> 32) * limite) >> 32);
+}
+
+double GeneradorAleatorio::realEntre(double min, double max) {
+    // 53 bits aleatorios -> [0, 1), independiente de la biblioteca estándar
+    const double unidad = static_cast<double>(siguiente() >> 11) * (1.0 / 9007199254740992.0);
+    return min + (max - min) * unidad;
+}
+
+Persona generarPersona(GeneradorAleatorio& rng, std::uint64_t id, std::pmr::memory_resource* recurso) {
+    // Mismas reglas que generarPersona(), con el flujo 'rng' en lugar de rand()
+    bool esHombre = rng.enteroHasta(2) != 0;
+
+    const std::string& nombre = esHombre ?
+        nombresMasculinos[rng.enteroHasta(static_cast<std::uint32_t>(nombresMasculinos.size()))] :
+        nombresFemeninos[rng.enteroHasta(static_cast<std::uint32_t>(nombresFemeninos.size()))];
+
+    const std::uint32_t totalApellidos = static_cast<std::uint32_t>(apellidos.size());
+    char buffer[MAX_APELLIDO];
+    std::string_view apellido = componerApellido(apellidos[rng.enteroHasta(totalApellidos)],
+                                                 apellidos[rng.enteroHasta(totalApellidos)], buffer);
+
+    CodigoCiudad ciudad = static_cast<CodigoCiudad>(
+        rng.enteroHasta(static_cast<std::uint32_t>(totalCiudadesColombia())));
+
+    int dia = 1 + static_cast<int>(rng.enteroHasta(28));
+    int mes = 1 + static_cast<int>(rng.enteroHasta(12));
+    int anio = 1960 + static_cast<int>(rng.enteroHasta(50));
+    std::int32_t fecha = anio * 10000 + mes * 100 + dia;
+
+    double ingresos = rng.realEntre(10000000, 500000000);
+    double patrimonio = rng.realEntre(0, 2000000000);
+    double deudas = rng.realEntre(0, patrimonio * 0.7);
+    bool declarante = (ingresos > 50000000) && (rng.enteroHasta(100) > 30);
+
+    return Persona(nombre, apellido, id, ciudad, fecha, ingresos, patrimonio, deudas, declarante, recurso);
+}
+
+// Filas por tramo: fija, no depende de los hilos (de ello depende el determinismo)
+static const std::size_t PERSONAS_POR_TRAMO = 65536;
+static const std::uint64_t ID_INICIAL = 1000000000;
+
+// Escribe en 'destino' las personas globales [primera, primera + cantidad).
+// 'primera' debe ser múltiplo de PERSONAS_POR_TRAMO para que cada tramo use
+// el mismo flujo aleatorio que tendría en una generación completa.
+// Con 'arena', los textos del tramo t se reservan en arena->tramo(t).
+static void generarRango(Persona* destino, std::uint64_t primera, std::size_t cantidad,
+                         std::uint64_t semilla, PoolHilos& pool, ArenaPersonas* arena) {
+    const std::size_t tramos = (cantidad + PERSONAS_POR_TRAMO - 1) / PERSONAS_POR_TRAMO;
+    const std::uint64_t primerTramo = primera / PERSONAS_POR_TRAMO;
+    if (arena) arena->preparar(tramos);
+
+    pool.paraCada(tramos, [&](std::size_t t) {
+        GeneradorAleatorio rng(semilla, primerTramo + t);
+        const std::size_t inicio = t * PERSONAS_POR_TRAMO;
+        const std::size_t fin = std::min(cantidad, inicio + PERSONAS_POR_TRAMO);
+        if (!arena) {
+            for (std::size_t i = inicio; i < fin; ++i) {
+                destino[i] = generarPersona(rng, ID_INICIAL + primera + i);
+            }
+            return;
+        }
+        std::pmr::memory_resource* recurso = arena->tramo(t);
+        for (std::size_t i = inicio; i < fin; ++i) {
+            // Asignar copiaría el texto al recurso del destino: se construye
+            // en su lugar, que conserva la arena
+            destino[i].~Persona();
+            ::new (static_cast<void*>(&destino[i])) Persona(generarPersona(rng, ID_INICIAL + primera + i, recurso));
+        }
+    });
+}
+
+std::vector<Persona> generarColeccionParalela(std::size_t n, std::uint64_t semilla, PoolHilos& pool,
+                                              ArenaPersonas* arena) {
+    // Salida dimensionada de antemano: cada tramo escribe en su propio rango
+    std::vector<Persona> personas(n);
+    generarRango(personas.data(), 0, n, semilla, pool, arena);
+    return personas;
+}
+
+void generarEnFlujo(std::uint64_t n, std::uint64_t semilla, PoolHilos& pool,
+                    SumideroPersonas& sumidero, std::size_t personasPorLote) {
+    // El lote se redondea a tramos completos para conservar el determinismo
+    std::size_t tramosPorLote = (personasPorLote + PERSONAS_POR_TRAMO - 1) / PERSONAS_POR_TRAMO;
+    if (tramosPorLote == 0) tramosPorLote = 1;
+    const std::size_t tamLote = tramosPorLote * PERSONAS_POR_TRAMO;
+
+    // Un único búfer reutilizado: la memoria no crece con n
+    std::vector<Persona> lote;
+    for (std::uint64_t primera = 0; primera < n; primera += tamLote) {
+        const std::size_t cantidad = static_cast<std::size_t>(std::min<std::uint64_t>(tamLote, n - primera));
+        lote.resize(cantidad);
+        generarRango(lote.data(), primera, cantidad, semilla, pool, nullptr);
+        sumidero.consumir(lote, primera);
+    }
+    sumidero.finalizar();
+}
+
+const Persona* buscarPorID(const std::vector<Persona>& personas, std::uint64_t id) {
+    // Con índice: posición en O(1), verificada contra el registro
+    if (indiceActivo.corresponde(personas)) {
+        std::uint32_t pos = indiceActivo.buscar(id);
+        if (pos != IndiceID::NO_ENCONTRADO && personas[pos].getId() == id) {
+            return &personas[pos];
+        }
+        return nullptr;
+    }
+
+    // Sin índice: búsqueda lineal por ID
     for (const auto& persona : personas) {
-        if (persona.getId() == id) {
+        if (persona.getId() == id) { // Comparación entera, sin cadenas
             return &persona; // Retorna dirección si encuentra coincidencia
         }
     }
     return nullptr; // Retorna nulo si no encuentra
+}
+
+const Persona* buscarPorID(const std::vector<Persona>& personas, const std::string& id) {
+    std::uint64_t valor;
+    try {
+        valor = Persona::convertirID(id);
+    } catch (const std::invalid_argument&) {
+        return nullptr; // Un texto no numérico no puede coincidir con ningún ID
+    }
+    return buscarPorID(personas, valor);
 }
\ No newline at end of file
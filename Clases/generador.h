@@ -2,15 +2,36 @@
 #define GENERADOR_H
 
 #include "persona.h"
+#include "arena.h"
+#include "indice_id.h"
+#include "paralelo.h"
+#include "sumidero.h"
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
+// Generador pseudoaleatorio sembrable (xoshiro256**) para generación paralela.
+// Cada instancia es un flujo independiente; no comparte estado con rand().
+class GeneradorAleatorio {
+public:
+    // El estado se deriva de (semilla, flujo) con splitmix64
+    GeneradorAleatorio(std::uint64_t semilla, std::uint64_t flujo);
+
+    std::uint64_t siguiente();
+    std::uint32_t enteroHasta(std::uint32_t limite); // Entero en [0, limite)
+    double realEntre(double min, double max);       // Decimal en [min, max)
+
+private:
+    std::uint64_t estado[4];
+};
+
 // --- Funciones para generación de datos aleatorios ---
 
-// Genera fecha aleatoria entre 1960-2010
-std::string generarFechaNacimiento();
+// Genera fecha aleatoria entre 1960-2010, empaquetada como AAAAMMDD
+std::int32_t generarFechaNacimiento();
 
 // Genera ID único secuencial
-std::string generarID();
+std::uint64_t generarID();
 
 // Genera número decimal en rango [min, max]
 double randomDouble(double min, double max);
@@ -21,8 +42,37 @@ Persona generarPersona();
 // Genera colección de n personas
 std::vector<Persona> generarColeccion(int n);
 
+// Crea una persona con datos aleatorios tomados de 'rng' y el ID indicado;
+// sus textos se reservan en 'recurso'
+Persona generarPersona(GeneradorAleatorio& rng, std::uint64_t id,
+                       std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
+
+// Genera n personas repartiendo el trabajo en el pool. La salida se divide en
+// tramos de tamaño fijo, cada uno con su propio flujo aleatorio e IDs
+// consecutivos desde 1000000000: con la misma semilla y n el resultado es
+// idéntico bit a bit sin importar el número de hilos.
+// Con 'arena' los textos quedan en sus arenas (una por tramo): liberar el
+// dataset no libera texto por texto, pero la arena debe destruirse después
+// del vector.
+std::vector<Persona> generarColeccionParalela(std::size_t n, std::uint64_t semilla, PoolHilos& pool,
+                                              ArenaPersonas* arena = nullptr);
+
+// Genera n personas por lotes y entrega cada lote a 'sumidero' sin conservarlo:
+// la memoria usada es la de un lote, no la de las n personas. Con la misma
+// semilla produce exactamente las mismas personas que generarColeccionParalela.
+// El tamaño del lote se redondea hacia arriba a múltiplos de 65536.
+void generarEnFlujo(std::uint64_t n, std::uint64_t semilla, PoolHilos& pool,
+                    SumideroPersonas& sumidero, std::size_t personasPorLote = 1 << 20);
+
+// Construye el índice de IDs para 'personas' y lo deja activo: mientras el
+// vector no cambie de tamaño ni de ubicación, buscarPorID lo consulta en O(1)
+const IndiceID& indexarPorID(const std::vector<Persona>& personas);
+
 // Busca persona por ID en un vector
+// Usa el índice activo si corresponde al vector; si no, búsqueda lineal
 // Retorna puntero a persona si la encuentra, nullptr si no
+const Persona* buscarPorID(const std::vector<Persona>& personas, std::uint64_t id);
+// Variante para IDs leídos como texto (nullptr si el texto no es numérico)
 const Persona* buscarPorID(const std::vector<Persona>& personas, const std::string& id);
 
 #endif // GENERADOR_H
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "indice_id.h"
+#include <stdexcept>
+
+const std::uint32_t IndiceID::NO_ENCONTRADO;
+
+// Mezcla de bits (finalizador de splitmix64) para repartir IDs consecutivos
+static std::uint64_t mezclar(std::uint64_t x) {
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+IndiceID::IndiceID()
+    : tipo(VACIO), datos(nullptr), total(0), base(0), mascara(0) {}
+
+void IndiceID::construir(const std::vector<Persona>& personas) {
+    // Las posiciones se guardan en 32 bits; NO_ENCONTRADO queda reservado
+    if (personas.size() >= NO_ENCONTRADO) {
+        throw std::length_error("Demasiadas personas para el índice de IDs");
+    }
+
+    tipo = VACIO;
+    datos = personas.data();
+    total = personas.size();
+    base = 0;
+    std::vector<std::uint32_t>().swap(desplazamientos);
+    std::vector<std::uint64_t>().swap(claves);
+    std::vector<std::uint32_t>().swap(posiciones);
+    mascara = 0;
+
+    if (personas.empty()) return;
+
+    // Primera pasada: rango de IDs y si son consecutivos desde el primero
+    std::uint64_t minimo = personas[0].getId();
+    std::uint64_t maximo = minimo;
+    bool secuencial = true;
+    for (std::size_t i = 1; i < total; ++i) {
+        std::uint64_t id = personas[i].getId();
+        if (id != personas[0].getId() + i) secuencial = false;
+        if (id < minimo) minimo = id;
+        if (id > maximo) maximo = id;
+    }
+
+    base = minimo;
+    if (secuencial) {
+        tipo = SECUENCIAL;
+        return;
+    }
+
+    // Rango a lo sumo el doble de personas: arreglo directo de desplazamientos
+    if (maximo - minimo < 2 * static_cast<std::uint64_t>(total)) {
+        tipo = DENSO;
+        desplazamientos.assign(static_cast<std::size_t>(maximo - minimo + 1), NO_ENCONTRADO);
+        for (std::size_t i = 0; i < total; ++i) {
+            std::uint32_t& celda = desplazamientos[static_cast<std::size_t>(personas[i].getId() - base)];
+            if (celda == NO_ENCONTRADO) celda = static_cast<std::uint32_t>(i); // Conserva el primero
+        }
+        return;
+    }
+
+    construirHash(personas);
+}
+
+void IndiceID::construirHash(const std::vector<Persona>& personas) {
+    tipo = HASH;
+
+    // Capacidad: potencia de dos con factor de carga <= 0.5
+    std::size_t capacidad = 16;
+    while (capacidad < 2 * total) capacidad <<= 1;
+    mascara = capacidad - 1;
+
+    claves.assign(capacidad, 0);
+    posiciones.assign(capacidad, NO_ENCONTRADO);
+
+    for (std::size_t i = 0; i < total; ++i) {
+        std::uint64_t id = personas[i].getId();
+        std::size_t ranura = static_cast<std::size_t>(mezclar(id)) & mascara;
+        // Sondeo lineal hasta una ranura libre o el mismo ID (se conserva el primero)
+        while (posiciones[ranura] != NO_ENCONTRADO && claves[ranura] != id) {
+            ranura = (ranura + 1) & mascara;
+        }
+        if (posiciones[ranura] == NO_ENCONTRADO) {
+            claves[ranura] = id;
+            posiciones[ranura] = static_cast<std::uint32_t>(i);
+        }
+    }
+}
+
+std::uint32_t IndiceID::buscar(std::uint64_t id) const {
+    switch (tipo) {
+        case SECUENCIAL:
+            if (id < base || id - base >= total) return NO_ENCONTRADO;
+            return static_cast<std::uint32_t>(id - base);
+
+        case DENSO:
+            if (id < base || id - base >= desplazamientos.size()) return NO_ENCONTRADO;
+            return desplazamientos[static_cast<std::size_t>(id - base)];
+
+        case HASH: {
+            std::size_t ranura = static_cast<std::size_t>(mezclar(id)) & mascara;
+            while (posiciones[ranura] != NO_ENCONTRADO) {
+                if (claves[ranura] == id) return posiciones[ranura];
+                ranura = (ranura + 1) & mascara;
+            }
+            return NO_ENCONTRADO;
+        }
+
+        default:
+            return NO_ENCONTRADO;
+    }
+}
+
+bool IndiceID::corresponde(const std::vector<Persona>& personas) const {
+    return tipo != VACIO && datos == personas.data() && total == personas.size();
+}
+
+IndiceID::Tipo IndiceID::getTipo() const { return tipo; }
+
+const char* IndiceID::nombreTipo() const {
+    switch (tipo) {
+        case SECUENCIAL: return "secuencial";
+        case DENSO:      return "denso";
+        case HASH:       return "hash";
+        default:         return "vacío";
+    }
+}
+
+std::size_t IndiceID::bytes() const {
+    return desplazamientos.capacity() * sizeof(std::uint32_t) +
+           claves.capacity() * sizeof(std::uint64_t) +
+           posiciones.capacity() * sizeof(std::uint32_t);
+}
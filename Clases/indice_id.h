@@ -0,0 +1,52 @@
+#ifndef INDICE_ID_H
+#define INDICE_ID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "persona.h"
+
+// Índice de búsqueda por ID en tiempo constante sobre un vector de personas.
+// Elige la representación según cómo estén distribuidos los IDs:
+//   - SECUENCIAL: ids[i] == base + i (caso del generador), sin memoria extra
+//   - DENSO: rango [min, max] pequeño, arreglo de desplazamientos por ID
+//   - HASH: cualquier otro caso, tabla de direccionamiento abierto
+class IndiceID {
+public:
+    enum Tipo { VACIO, SECUENCIAL, DENSO, HASH };
+
+    static const std::uint32_t NO_ENCONTRADO = 0xFFFFFFFFu;
+
+    IndiceID();
+
+    // Reconstruye el índice para 'personas' (recuerda el vector indexado)
+    void construir(const std::vector<Persona>& personas);
+
+    // Posición del ID en el vector indexado, o NO_ENCONTRADO
+    std::uint32_t buscar(std::uint64_t id) const;
+
+    // true si el índice se construyó sobre este mismo vector y tamaño
+    bool corresponde(const std::vector<Persona>& personas) const;
+
+    Tipo getTipo() const;
+    const char* nombreTipo() const;
+    std::size_t bytes() const; // Memoria ocupada por las estructuras del índice
+
+private:
+    Tipo tipo;
+    const Persona* datos;  // Vector indexado (identidad, no se accede por aquí)
+    std::size_t total;     // Número de personas indexadas
+    std::uint64_t base;    // Menor ID (SECUENCIAL y DENSO)
+
+    std::vector<std::uint32_t> desplazamientos; // DENSO: id - base -> posición
+
+    // HASH: claves y posiciones en paralelo; capacidad potencia de dos
+    std::vector<std::uint64_t> claves;
+    std::vector<std::uint32_t> posiciones;
+    std::size_t mascara;
+
+    void construirHash(const std::vector<Persona>& personas);
+};
+
+#endif // INDICE_ID_H
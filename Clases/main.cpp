@@ -5,8 +5,17 @@
 #include <memory>
 #include <map>
 #include <ctime>
+#include <cstdint>
 
+#include "arena.h"
 #include "persona.h"
+#include "persona_store.h"
+#include "analitica.h"
+#include "paralelo.h"
+#include "sumidero.h"
+#include "snapshot.h"
+#include "csv.h"
+#include "formateador.h"
 #include "generador.h"
 #include "monitor.h"
 
@@ -15,6 +24,7 @@ using std::cin;
 using std::string;
 using std::vector;
 using std::map;
+using std::uint32_t;
 
 /**
  * Muestra el menú principal de la aplicación.
@@ -30,16 +40,68 @@ void mostrarMenu() {
     cout << "\n6. Mostrar estadísticas de rendimiento";
     cout << "\n7. Exportar estadísticas a CSV";
     cout << "\n8. Salir";
+    cout << "\n9. Configurar número de hilos";
+    cout << "\n10. Generar en flujo sin conservar el dataset";
+    cout << "\n11. Guardar dataset en snapshot binario";
+    cout << "\n12. Cargar snapshot binario (mmap)";
+    cout << "\n13. Exportar dataset a CSV";
+    cout << "\n14. Importar dataset desde CSV";
+    cout << "\n15. Exportar traza de tiempos (Chrome JSON)";
+    cout << "\n16. Totales de dinero exactos por ciudad (centavos)";
     cout << "\nSeleccione una opción: ";
 }
 
+/**
+ * Construye el almacén columnar y el índice de IDs de un dataset recién
+ * creado o importado, registrando ambos pasos en el monitor.
+ */
+void prepararConsultas(const vector<Persona>& personas, std::unique_ptr<PersonaStore>& columnas,
+                       Monitor& monitor) {
+    // Construcción del almacén columnar
+    monitor.iniciar_tiempo();
+    long memoria_inicio = monitor.obtener_memoria();
+
+    columnas.reset(new PersonaStore(personas));
+
+    double t_ms = monitor.detener_tiempo();
+    long mem_kb = monitor.obtener_memoria() - memoria_inicio;
+    cout << "Almacén columnar construido en " << t_ms << " ms, Memoria: "
+         << mem_kb << " KB\n";
+    monitor.registrar("Construir columnas", t_ms, mem_kb);
+
+    // Índice de IDs para búsquedas O(1) en la opción 3
+    monitor.iniciar_tiempo();
+    const IndiceID& indice = indexarPorID(personas);
+    t_ms = monitor.detener_tiempo();
+    mem_kb = static_cast<long>(indice.bytes() / 1024);
+    cout << "Índice de IDs (" << indice.nombreTipo() << ") construido en "
+         << t_ms << " ms, Memoria: " << mem_kb << " KB\n";
+    monitor.registrar("Indexar IDs", t_ms, mem_kb);
+}
+
 int main() {
     srand(time(nullptr)); // Semilla para generación aleatoria
 
+    // Arenas con los textos del dataset generado. Se declara antes que el
+    // dataset para destruirse después de él
+    std::unique_ptr<ArenaPersonas> arenaDataset = nullptr;
     // Dataset bajo propiedad única
     std::unique_ptr<vector<Persona>> dataset = nullptr;
+    // Copia columnar del dataset para los recorridos analíticos
+    std::unique_ptr<PersonaStore> columnas = nullptr;
+    // Snapshot mapeado; si existe, 'columnas' apunta a sus páginas y el
+    // dataset solo se materializa cuando una opción necesita objetos Persona
+    std::unique_ptr<SnapshotMapeado> snapshot = nullptr;
 
     Monitor monitor; // Medición de rendimiento
+    // Contadores de hardware si el kernel los permite (si no, solo tiempo y memoria).
+    // Se activan antes de crear el pool para que sus hilos los hereden
+    monitor.activar_contadores();
+    cout << "Contadores de hardware: " << monitor.estado_contadores() << "\n";
+
+    // Hilos para los recorridos paralelos (por defecto, todos los núcleos)
+    std::unique_ptr<PoolHilos> pool(new PoolHilos());
+    pool->setMonitor(&monitor); // Tareas del pool en la traza
 
     int opcion;
     do {
@@ -52,11 +114,37 @@ int main() {
         string idBuscado;
         long memoria_inicio = 0;
 
+        // Tramo de toda la opción; los tramos internos quedan como sus hijos.
+        // Las opciones que piden datos lo abren después de leerlos, para no
+        // medir lo que tarda el usuario en escribir.
+        std::unique_ptr<Monitor::Tramo> tramoOpcion;
+        auto abrirTramoOpcion = [&]() {
+            tramoOpcion.reset(new Monitor::Tramo(monitor, "Opción " + std::to_string(opcion)));
+        };
+        bool pideDatos = opcion == 0 || opcion == 2 || opcion == 3 || opcion == 9 || opcion == 10 ||
+                         opcion == 11 || opcion == 12 || opcion == 13 || opcion == 14;
+        if (!pideDatos) abrirTramoOpcion();
+
+        // Las opciones que recorren objetos Persona necesitan el dataset en memoria
+        bool usaDataset = opcion == 1 || opcion == 2 || opcion == 3 || opcion == 5 ||
+                          opcion == 11 || opcion == 13;
+        if (usaDataset && !dataset && snapshot) {
+            monitor.iniciar_tiempo();
+            memoria_inicio = monitor.obtener_memoria();
+            dataset.reset(new vector<Persona>(snapshot->materializar()));
+            indexarPorID(*dataset);
+            double t_ms = monitor.detener_tiempo();
+            long mem_kb = monitor.obtener_memoria() - memoria_inicio;
+            cout << "\nSnapshot materializado en " << t_ms << " ms, Memoria: " << mem_kb << " KB\n";
+            monitor.registrar("Materializar snapshot", t_ms, mem_kb);
+        }
+
         switch (opcion) {
             case 0: { // Crear nuevo conjunto de datos
                 int n;
                 cout << "\nIngrese el número de personas a generar: ";
                 cin >> n;
+                abrirTramoOpcion();
 
                 monitor.iniciar_tiempo();
                 memoria_inicio = monitor.obtener_memoria();
@@ -66,10 +154,18 @@ int main() {
                     break;
                 }
 
-                // Generar y mover al puntero inteligente
-                auto nuevas = generarColeccion(n);
+                // Generar en paralelo (reproducible con la semilla) y mover al puntero inteligente
+                std::uint64_t semilla = static_cast<std::uint64_t>(time(nullptr));
+                cout << "Semilla de generación: " << semilla << "\n";
+                // Los textos van a arenas nuevas: liberar el dataset es liberar sus bloques
+                std::unique_ptr<ArenaPersonas> arenaNueva(new ArenaPersonas());
+                auto nuevas = generarColeccionParalela(static_cast<size_t>(n), semilla, *pool,
+                                                       arenaNueva.get());
                 totalRegistros = nuevas.size();
+                columnas.reset(); // Antes que el snapshot: puede apuntar a sus páginas
+                snapshot.reset();
                 dataset.reset(new vector<Persona>(std::move(nuevas)));
+                arenaDataset = std::move(arenaNueva); // El dataset anterior ya no usa la arena anterior
 
                 // Métricas
                 double t_ms = monitor.detener_tiempo();
@@ -79,6 +175,8 @@ int main() {
                      << t_ms << " ms, Memoria: " << mem_kb << " KB\n";
 
                 monitor.registrar("Crear datos", t_ms, mem_kb);
+
+                prepararConsultas(*dataset, columnas, monitor);
                 break;
             }
 
@@ -92,11 +190,16 @@ int main() {
                 memoria_inicio = monitor.obtener_memoria();
 
                 totalRegistros = dataset->size();
-                cout << "\n=== RESUMEN DE PERSONAS (" << totalRegistros << ") ===\n";
-                for (size_t i = 0; i < totalRegistros; ++i) {
-                    cout << i << ". ";
-                    (*dataset)[i].mostrarResumen();
-                    cout << "\n";
+                {
+                    // Listado completo en un búfer grande: pocas llamadas a write()
+                    FormateadorBuffer salida;
+                    salida.texto("\n=== RESUMEN DE PERSONAS (").entero(totalRegistros).texto(") ===\n");
+                    for (size_t i = 0; i < totalRegistros; ++i) {
+                        salida.entero(i).texto(". ");
+                        (*dataset)[i].escribirResumen(salida);
+                        salida.caracter('\n');
+                    }
+                    salida.volcar();
                 }
 
                 double t_ms = monitor.detener_tiempo();
@@ -111,15 +214,19 @@ int main() {
                     break;
                 }
 
+                totalRegistros = dataset->size();
+                cout << "\nIngrese el índice (0-" << totalRegistros - 1 << "): ";
+                const bool indiceLeido = static_cast<bool>(cin >> indice);
+                abrirTramoOpcion();
                 monitor.iniciar_tiempo();
                 memoria_inicio = monitor.obtener_memoria();
 
-                totalRegistros = dataset->size();
-                cout << "\nIngrese el índice (0-" << totalRegistros - 1 << "): ";
-                if (cin >> indice) {
+                if (indiceLeido) {
                     if (indice >= 0 && static_cast<size_t>(indice) < totalRegistros) {
                         const Persona& p = (*dataset)[static_cast<size_t>(indice)];
-                        p.mostrar();
+                        FormateadorBuffer salida;
+                        p.escribir(salida);
+                        salida.volcar();
                         // Ejemplo de métodos de instancia:
                         cout << " -> Edad (método de instancia): " << p.calcularEdad() << "\n";
                         // Ejemplo de métodos estáticos:
@@ -148,11 +255,12 @@ int main() {
 
                 cout << "\nIngrese el ID a buscar: ";
                 cin >> idBuscado;
+                abrirTramoOpcion();
 
                 monitor.iniciar_tiempo();
                 memoria_inicio = monitor.obtener_memoria();
 
-                // Se asume que buscarPorID está en generador.h/.cpp (devuelve const Persona* o nullptr)
+                // buscarPorID consulta el índice de IDs construido en la opción 0
                 if (const Persona* p = buscarPorID(*dataset, idBuscado)) {
                     p->mostrar();
                     cout << " -> Edad: " << p->calcularEdad() << "\n";
@@ -169,7 +277,7 @@ int main() {
 
             // ===================== APUNTADORES / REFERENCIAS =====================
             case 4: {
-                if (!dataset || dataset->empty()) {
+                if (!columnas || columnas->empty()) {
                     cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                     break;
                 }
@@ -177,95 +285,76 @@ int main() {
                 monitor.iniciar_tiempo();
                 memoria_inicio = monitor.obtener_memoria();
 
-                try {
-                    map<string, vector<Persona>> porCiudad;
-
-                    Persona::agruparPorCiudad(*dataset, porCiudad);
-                    cout << "[REF] agruparPorCiudad -> " << porCiudad.size() << " ciudades\n";
-
-
-                    Persona masLongeva;
-                    Persona::personaMaxLongeva(*dataset, masLongeva);
-                    cout << "\n[REF] Más longeva en el país: "; masLongeva.mostrarResumen(); cout << "\n";
-
-                    // Persona más longeva por ciudad
-                    for (const auto& par : porCiudad) {
-                        const string& ciudad = par.first;
-                        const vector<Persona>& personas = par.second;
-                        if (!personas.empty()) {
-                            Persona masLongevaCiudad;
-                            Persona::personaMaxLongeva(personas, masLongevaCiudad);
-                            cout << "[REF] Más longeva en " << ciudad << ": ";
-                            masLongevaCiudad.mostrarResumen();
-                            cout << "\n";
-                        }
-                    }
-                    
-                    Persona mayorPatri;
-                    Persona::personaMaxPatrimonio(*dataset, mayorPatri);
-                    cout << "[REF] Mayor patrimonio en el país: "; mayorPatri.mostrarResumen(); cout << "\n";
-
-                    for (const auto& par : porCiudad) {
-                        const string& ciudad = par.first;
-                        const vector<Persona>& personas = par.second;
-                        if (!personas.empty()) {
-                            Persona mayorPatrimonioCiudad;
-                            Persona::personaMaxPatrimonio(personas, mayorPatrimonioCiudad);
-                            cout << "[REF] Mayor patrimonio en " << ciudad << ": ";
-                            mayorPatrimonioCiudad.mostrarResumen();
-                            cout << "\n";
-                        }
+                // Todos los agregados en una sola pasada sobre el almacén columnar,
+                // repartida entre los hilos del pool
+                Monitor::Tramo tramoReporte(monitor, "Reporte analítico");
+                ReporteAnalitico reporte = generarReporteParalelo(*columnas, *pool);
+                tramoReporte.cerrar();
+                Monitor::Tramo tramoImpresion(monitor, "Imprimir reporte");
+                // Las filas del reporte se muestran desde el dataset o, si solo
+                // hay snapshot, construyendo la persona desde las páginas mapeadas
+                auto fila = [&](uint32_t i) {
+                    return dataset ? (*dataset)[i] : snapshot->persona(i);
+                };
+
+                // Ciudades presentes, en orden alfabético como los grupos por mapa
+                map<string, CodigoCiudad> ciudadesPresentes;
+                for (size_t codigo = 0; codigo < reporte.porCiudad.size(); ++codigo) {
+                    if (reporte.porCiudad[codigo].total > 0) {
+                        CodigoCiudad c = static_cast<CodigoCiudad>(codigo);
+                        ciudadesPresentes[nombreCiudad(c)] = c;
                     }
+                }
+                cout << "[REF] agruparPorCiudad -> " << ciudadesPresentes.size() << " ciudades\n";
 
-                    // Mayor patrimonio por grupo de declaración (A, B, C)
-                    map<string, vector<Persona>> porDeclaracionGrupo;
-                    Persona::agruparPorDeclaracion(*dataset, porDeclaracionGrupo);
-
-                    for (const auto& par : porDeclaracionGrupo) {
-                        const string& grupo = par.first;
-                        const vector<Persona>& personas = par.second;
-                        if (!personas.empty()) {
-                            Persona mayorPatrimonioGrupo;
-                            Persona::personaMaxPatrimonio(personas, mayorPatrimonioGrupo);
-                            cout << "[REF] Mayor patrimonio en grupo " << grupo << ": ";
-                            mayorPatrimonioGrupo.mostrarResumen();
-                            cout << "\n";
-                        }
-                    }
+                cout << "\n[REF] Más longeva en el país: ";
+                fila(reporte.pais.masLongeva).mostrarResumen(); cout << "\n";
 
-                    Persona menorPatri;
-                    Persona::personaMinPatrimonio(*dataset, menorPatri);
-                    cout << "[REF] Menor patrimonio: "; menorPatri.mostrarResumen(); cout << "\n";
+                // Persona más longeva por ciudad
+                for (const auto& par : ciudadesPresentes) {
+                    cout << "[REF] Más longeva en " << par.first << ": ";
+                    fila(reporte.porCiudad[par.second].masLongeva).mostrarResumen();
+                    cout << "\n";
+                }
 
-                    Persona mayorDeuda;
-                    Persona::personaMaxDeuda(*dataset, mayorDeuda);
-                    cout << "[REF] Mayor deuda: "; mayorDeuda.mostrarResumen(); cout << "\n";
-                } catch (const std::exception& e) {
-                    cout << "Error en búsquedas por referencia: " << e.what() << "\n";
+                cout << "[REF] Mayor patrimonio en el país: ";
+                fila(reporte.pais.maxPatrimonio).mostrarResumen(); cout << "\n";
+
+                for (const auto& par : ciudadesPresentes) {
+                    cout << "[REF] Mayor patrimonio en " << par.first << ": ";
+                    fila(reporte.porCiudad[par.second].maxPatrimonio).mostrarResumen();
+                    cout << "\n";
                 }
 
-                // Declarantes por ciudad (ref)
-                {
-                    map<string, vector<Persona>> declPorCiudad;
-                    Persona::declarantePorCiudad(*dataset, declPorCiudad);
-                    cout << "[REF] declarantePorCiudad -> " << declPorCiudad.size()
-                         << " ciudades con declarantes\n";
+                // Mayor patrimonio por grupo de declaración (A, B, C)
+                const char* letras[3] = {"A", "B", "C"};
+                for (int g = 0; g < 3; ++g) {
+                    if (reporte.porGrupoDIAN[g].total > 0) {
+                        cout << "[REF] Mayor patrimonio en grupo " << letras[g] << ": ";
+                        fila(reporte.porGrupoDIAN[g].maxPatrimonio).mostrarResumen();
+                        cout << "\n";
+                    }
                 }
 
-                {
-                    map<string, int> contador;
-                    auto gruposPtr = Persona::agruparDeclarantesPorCalendarioPtr(*dataset, &contador);
-                    cout << "[PTR] Calendario -> A:" << contador["Grupo A"]
-                         << " B:" << contador["Grupo B"]
-                         << " C:" << contador["Grupo C"] << "\n";
-
-                    for (auto etiqueta : {"Grupo A","Grupo B","Grupo C"}) {
-                        auto it = gruposPtr.find(etiqueta);
-                        if (it != gruposPtr.end() && !it->second.empty()) {
-                            cout << "  [PTR] Ejemplo " << etiqueta << ": ";
-                            it->second.front()->mostrarResumen();
-                            cout << "\n";
-                        }
+                cout << "[REF] Menor patrimonio: ";
+                fila(reporte.pais.minPatrimonio).mostrarResumen(); cout << "\n";
+
+                cout << "[REF] Mayor deuda: ";
+                fila(reporte.pais.maxDeuda).mostrarResumen(); cout << "\n";
+
+                // Declarantes por ciudad: toda ciudad presente cuenta, como en declarantePorCiudad
+                cout << "[REF] declarantePorCiudad -> " << ciudadesPresentes.size()
+                     << " ciudades con declarantes\n";
+
+                cout << "[PTR] Calendario -> A:" << reporte.declarantesCalendario[0]
+                     << " B:" << reporte.declarantesCalendario[1]
+                     << " C:" << reporte.declarantesCalendario[2] << "\n";
+
+                for (int g = 0; g < 3; ++g) {
+                    if (reporte.primerDeclaranteCalendario[g] != SIN_INDICE) {
+                        cout << "  [PTR] Ejemplo " << Persona::etiquetaGrupoDIAN(g) << ": ";
+                        fila(reporte.primerDeclaranteCalendario[g]).mostrarResumen();
+                        cout << "\n";
                     }
                 }
 
@@ -282,9 +371,15 @@ int main() {
                     break;
                 }
 
+                // Los grupos por valor de esta opción se reservan en una arena
+                // propia y se liberan juntos al terminar (los resultados se
+                // declaran después, así que se destruyen antes que ella)
+                ArenaConsulta arenaConsulta;
+
                 monitor.iniciar_tiempo();
                 memoria_inicio = monitor.obtener_memoria();
 
+                Monitor::Tramo tramoExtremos(monitor, "Extremos del país");
                 try {
                     Persona a = Persona::personaMaxLongevaValor(*dataset);
                     cout << "\n[VALOR] Más longeva: "; a.mostrarResumen(); cout << "\n";
@@ -300,13 +395,17 @@ int main() {
                 } catch (const std::exception& e) {
                     cout << "Error en búsquedas por valor: " << e.what() << "\n";
                 }
+                tramoExtremos.cerrar();
 
-                auto gCiudad = Persona::agruparPorCiudadValor(*dataset);
+                Monitor::Tramo tramoCiudad(monitor, "Agrupar por ciudad");
+                auto gCiudad = Persona::agruparPorCiudadValor(*dataset, arenaConsulta.recurso());
+                tramoCiudad.cerrar();
                 cout << "[VALOR] agruparPorCiudadValor -> " << gCiudad.size() << " ciudades\n";
 
+                Monitor::Tramo tramoLongeva(monitor, "Más longeva por ciudad");
                 for (const auto& par : gCiudad) {
-                    const string& ciudad = par.first;
-                    const vector<Persona>& personas = par.second;
+                    const std::pmr::string& ciudad = par.first;
+                    VistaPersonas personas = par.second;
                     if (!personas.empty()) {
                         Persona masLongevaCiudad = Persona::personaMaxLongevaValor(personas);
                         cout << "[VALOR] Más longeva en " << ciudad << ": ";
@@ -315,11 +414,16 @@ int main() {
                     }
                 }
 
-                auto grupoDecl = Persona::agruparPorDeclaracionValor(*dataset);
+                tramoLongeva.cerrar();
 
+                Monitor::Tramo tramoDeclaracion(monitor, "Agrupar por declaración");
+                auto grupoDecl = Persona::agruparPorDeclaracionValor(*dataset, arenaConsulta.recurso());
+                tramoDeclaracion.cerrar();
+
+                Monitor::Tramo tramoPatrimonio(monitor, "Mayor patrimonio por grupo");
                 for (const auto& par : gCiudad) {
-                    const string& ciudad = par.first;
-                    const vector<Persona>& personas = par.second;
+                    const std::pmr::string& ciudad = par.first;
+                    VistaPersonas personas = par.second;
                     if (!personas.empty()) {
                         Persona mayorPatrimonioCiudad = Persona::personaMaxPatrimonioValor(personas);
                         cout << "[VALOR] Mayor patrimonio en " << ciudad << ": ";
@@ -329,8 +433,8 @@ int main() {
                 }
 
                 for (const auto& par : grupoDecl) {
-                    const string& grupo = par.first;
-                    const vector<Persona>& personas = par.second;
+                    const std::pmr::string& grupo = par.first;
+                    VistaPersonas personas = par.second;
                     if (!personas.empty()) {
                         Persona mayorPatrimonioGrupo = Persona::personaMaxPatrimonioValor(personas);
                         cout << "[VALOR] Mayor patrimonio en grupo " << grupo << ": ";
@@ -339,18 +443,27 @@ int main() {
                     }
                 }
 
-                auto declCiudad = Persona::declarantePorCiudadValor(*dataset);
+                tramoPatrimonio.cerrar();
+
+                Monitor::Tramo tramoDeclarantes(monitor, "Declarantes por ciudad");
+                auto declCiudad = Persona::declarantePorCiudadValor(*dataset, arenaConsulta.recurso());
+                tramoDeclarantes.cerrar();
                 cout << "[VALOR] declarantePorCiudadValor -> " << declCiudad.size()
                      << " ciudades con declarantes\n";
 
                 // Calendario por valor (estructura con conteo)
-                Persona::CalendarioAgrupadito cal = Persona::agruparDeclarantesPorCalendarioValor(*dataset);
+                Monitor::Tramo tramoCalendario(monitor, "Calendario");
+                Persona::CalendarioAgrupadito cal =
+                    Persona::agruparDeclarantesPorCalendarioValor(*dataset, arenaConsulta.recurso());
+                tramoCalendario.cerrar();
                 cout << "[VALOR] Calendario -> A:" << cal.conteo["Grupo A"]
                      << " B:" << cal.conteo["Grupo B"]
                      << " C:" << cal.conteo["Grupo C"] << "\n";
 
                 // Agrupar por declaración (por valor) — usa claves "A","B","C"
-                auto gruposDecl = Persona::agruparPorDeclaracionValor(*dataset);
+                Monitor::Tramo tramoDeclaracion2(monitor, "Agrupar por declaración");
+                auto gruposDecl = Persona::agruparPorDeclaracionValor(*dataset, arenaConsulta.recurso());
+                tramoDeclaracion2.cerrar();
                 cout << "[VALOR] agruparPorDeclaracionValor -> "
                      << "A:" << gruposDecl["A"].size()
                      << " B:" << gruposDecl["B"].size()
@@ -374,13 +487,272 @@ int main() {
                 cout << "Saliendo...\n";
                 break;
 
+            case 9: { // Configurar hilos
+                unsigned hilos;
+                cout << "\nHilos actuales: " << pool->getHilos()
+                     << ". Ingrese el nuevo número (0 = todos los núcleos): ";
+                if (cin >> hilos) {
+                    abrirTramoOpcion();
+                    pool.reset(); // Termina los hilos actuales antes de crear los nuevos
+                    pool.reset(new PoolHilos(hilos));
+                    pool->setMonitor(&monitor);
+                    cout << "Usando " << pool->getHilos() << " hilos\n";
+                } else {
+                    cout << "Entrada inválida!\n";
+                    cin.clear();
+                    cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                }
+                break;
+            }
+
+            case 10: { // Generación en flujo con memoria acotada
+                std::uint64_t n;
+                int destino;
+                cout << "\nIngrese el número de personas a generar: ";
+                if (!(cin >> n) || n == 0) {
+                    cout << "Error: Debe generar al menos 1 persona\n";
+                    cin.clear();
+                    cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    break;
+                }
+                cout << "Destino (1 = reporte agregado, 2 = archivo CSV): ";
+                cin >> destino;
+
+                std::uint64_t semilla = static_cast<std::uint64_t>(time(nullptr));
+                cout << "Semilla de generación: " << semilla << "\n";
+
+                try {
+                    if (destino == 1) {
+                        abrirTramoOpcion();
+                        monitor.iniciar_tiempo();
+                        memoria_inicio = monitor.obtener_memoria();
+
+                        SumideroAgregado agregado(*pool);
+                        generarEnFlujo(n, semilla, *pool, agregado);
+
+                        double t_ms = monitor.detener_tiempo();
+                        long mem_kb = monitor.obtener_memoria() - memoria_inicio;
+
+                        const ExtremosGrupo& pais = agregado.getPais();
+                        cout << "Personas: " << pais.total << ", declarantes: " << pais.declarantes << "\n";
+                        cout << "[FLUJO] Más longeva en el país: ";
+                        pais.masLongeva.mostrarResumen(); cout << "\n";
+                        cout << "[FLUJO] Mayor patrimonio en el país: ";
+                        pais.maxPatrimonio.mostrarResumen(); cout << "\n";
+                        cout << "[FLUJO] Menor patrimonio: ";
+                        pais.minPatrimonio.mostrarResumen(); cout << "\n";
+                        cout << "[FLUJO] Mayor deuda: ";
+                        pais.maxDeuda.mostrarResumen(); cout << "\n";
+                        for (int g = 0; g < 3; ++g) {
+                            cout << "[FLUJO] " << Persona::etiquetaGrupoDIAN(g) << ": "
+                                 << agregado.getGrupoDIAN(g).total << " personas\n";
+                        }
+
+                        cout << "Flujo procesado en " << t_ms << " ms, Memoria: " << mem_kb << " KB\n";
+                        monitor.registrar("Generar en flujo (agregado)", t_ms, mem_kb);
+                    } else if (destino == 2) {
+                        string ruta;
+                        cout << "Ruta del archivo: ";
+                        cin >> ruta;
+                        abrirTramoOpcion();
+
+                        monitor.iniciar_tiempo();
+                        memoria_inicio = monitor.obtener_memoria();
+
+                        SumideroArchivo archivo(ruta, *pool);
+                        generarEnFlujo(n, semilla, *pool, archivo);
+
+                        double t_ms = monitor.detener_tiempo();
+                        long mem_kb = monitor.obtener_memoria() - memoria_inicio;
+                        cout << "Escritas " << archivo.getEscritas() << " personas en " << ruta
+                             << " en " << t_ms << " ms, Memoria: " << mem_kb << " KB\n";
+                        monitor.registrar("Generar en flujo (archivo)", t_ms, mem_kb);
+                    } else {
+                        cout << "Destino inválido!\n";
+                    }
+                } catch (const std::exception& e) {
+                    cout << "Error: " << e.what() << "\n";
+                }
+                break;
+            }
+
+            case 11: { // Guardar snapshot
+                if (!dataset || dataset->empty()) {
+                    cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                    break;
+                }
+                string ruta;
+                cout << "\nRuta del snapshot: ";
+                cin >> ruta;
+                abrirTramoOpcion();
+
+                monitor.iniciar_tiempo();
+                try {
+                    guardarSnapshot(ruta, *dataset);
+                    double t_ms = monitor.detener_tiempo();
+                    cout << "Snapshot de " << dataset->size() << " personas guardado en "
+                         << t_ms << " ms\n";
+                    monitor.registrar("Guardar snapshot", t_ms, 0);
+                } catch (const std::exception& e) {
+                    monitor.detener_tiempo();
+                    cout << "Error: " << e.what() << "\n";
+                }
+                break;
+            }
+
+            case 12: { // Cargar snapshot con mmap
+                string ruta;
+                cout << "\nRuta del snapshot: ";
+                cin >> ruta;
+                abrirTramoOpcion();
+
+                monitor.iniciar_tiempo();
+                memoria_inicio = monitor.obtener_memoria();
+                try {
+                    std::unique_ptr<SnapshotMapeado> nuevo(new SnapshotMapeado(ruta));
+
+                    // El almacén anterior puede apuntar al snapshot anterior
+                    columnas.reset(new PersonaStore());
+                    dataset.reset();
+                    arenaDataset.reset();
+                    snapshot = std::move(nuevo);
+                    snapshot->vincular(*columnas);
+
+                    double t_ms = monitor.detener_tiempo();
+                    long mem_kb = monitor.obtener_memoria() - memoria_inicio;
+                    cout << "Snapshot de " << snapshot->size() << " personas ("
+                         << snapshot->bytes() / 1024 << " KB mapeados) cargado en "
+                         << t_ms << " ms, Memoria: " << mem_kb << " KB\n";
+                    monitor.registrar("Cargar snapshot (mmap)", t_ms, mem_kb);
+                } catch (const std::exception& e) {
+                    monitor.detener_tiempo();
+                    cout << "Error: " << e.what() << "\n";
+                }
+                break;
+            }
+
+            case 13: { // Exportar CSV
+                if (!dataset || dataset->empty()) {
+                    cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                    break;
+                }
+                string ruta;
+                cout << "\nRuta del archivo CSV: ";
+                cin >> ruta;
+                abrirTramoOpcion();
+
+                monitor.iniciar_tiempo();
+                try {
+                    exportarCSV(ruta, *dataset, *pool);
+                    double t_ms = monitor.detener_tiempo();
+                    cout << "Exportadas " << dataset->size() << " personas en " << t_ms << " ms\n";
+                    monitor.registrar("Exportar CSV", t_ms, 0);
+                } catch (const std::exception& e) {
+                    monitor.detener_tiempo();
+                    cout << "Error: " << e.what() << "\n";
+                }
+                break;
+            }
+
+            case 14: { // Importar CSV
+                string ruta;
+                cout << "\nRuta del archivo CSV: ";
+                cin >> ruta;
+                abrirTramoOpcion();
+
+                monitor.iniciar_tiempo();
+                memoria_inicio = monitor.obtener_memoria();
+                try {
+                    auto importadas = importarCSV(ruta, *pool);
+                    columnas.reset(); // Antes que el snapshot: puede apuntar a sus páginas
+                    snapshot.reset();
+                    dataset.reset(new vector<Persona>(std::move(importadas)));
+                    arenaDataset.reset(); // Las importadas usan el recurso por defecto
+
+                    double t_ms = monitor.detener_tiempo();
+                    long mem_kb = monitor.obtener_memoria() - memoria_inicio;
+                    cout << "Importadas " << dataset->size() << " personas en "
+                         << t_ms << " ms, Memoria: " << mem_kb << " KB\n";
+                    monitor.registrar("Importar CSV", t_ms, mem_kb);
+
+                    prepararConsultas(*dataset, columnas, monitor);
+                } catch (const std::exception& e) {
+                    monitor.detener_tiempo();
+                    cout << "Error: " << e.what() << "\n";
+                }
+                break;
+            }
+
+            case 15: // Exportar traza
+                monitor.exportar_traza();
+                break;
+
+            case 16: { // Totales de dinero exactos
+                if (!columnas || columnas->empty()) {
+                    cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                    break;
+                }
+
+                // Las columnas en centavos se crean la primera vez que se piden
+                if (!columnas->tieneCentavos()) {
+                    monitor.iniciar_tiempo();
+                    memoria_inicio = monitor.obtener_memoria();
+                    try {
+                        columnas->materializarCentavos();
+                    } catch (const std::exception& e) {
+                        monitor.detener_tiempo();
+                        cout << "Error: " << e.what() << "\n";
+                        break;
+                    }
+                    double t_ms = monitor.detener_tiempo();
+                    long mem_kb = monitor.obtener_memoria() - memoria_inicio;
+                    cout << "\nColumnas en centavos creadas en " << t_ms << " ms, Memoria: "
+                         << mem_kb << " KB\n";
+                    monitor.registrar("Columnas en centavos", t_ms, mem_kb);
+                }
+
+                monitor.iniciar_tiempo();
+                memoria_inicio = monitor.obtener_memoria();
+                ReporteDinero reporte = generarReporteDineroParalelo(*columnas, *pool);
+                double t_ms = monitor.detener_tiempo();
+                long mem_kb = monitor.obtener_memoria() - memoria_inicio;
+
+                // Ciudades presentes, en orden alfabético como en la opción 4
+                map<string, CodigoCiudad> ciudadesPresentes;
+                for (size_t codigo = 0; codigo < reporte.porCiudad.size(); ++codigo) {
+                    if (reporte.porCiudad[codigo].personas > 0) {
+                        CodigoCiudad c = static_cast<CodigoCiudad>(codigo);
+                        ciudadesPresentes[nombreCiudad(c)] = c;
+                    }
+                }
+
+                auto mostrarTotales = [](const string& nombre, const TotalesDinero& t) {
+                    cout << "[CENTAVOS] " << nombre << ": " << t.personas << " personas"
+                         << " | ingresos $" << textoCentavos(t.ingresos)
+                         << " (promedio $" << textoCentavos(promedioCentavos(t.ingresos, t.personas)) << ")"
+                         << " | patrimonio neto $" << textoCentavos(t.patrimonioNeto())
+                         << " (promedio $" << textoCentavos(promedioCentavos(t.patrimonioNeto(), t.personas)) << ")\n";
+                };
+                cout << "\n";
+                for (const auto& par : ciudadesPresentes) {
+                    mostrarTotales(par.first, reporte.porCiudad[par.second]);
+                }
+                mostrarTotales("País", reporte.pais);
+                cout << "[CENTAVOS] Deudas del país: $" << textoCentavos(reporte.pais.deudas) << "\n";
+
+                cout << "Totales calculados en " << t_ms << " ms con " << pool->getHilos()
+                     << " hilos, Memoria: " << mem_kb << " KB\n";
+                monitor.registrar("Totales de dinero", t_ms, mem_kb);
+                break;
+            }
+
             default:
                 cout << "Opción inválida!\n";
         }
 
 
-        if (opcion >= 0 && opcion <= 5) {
-            double t_ms = monitor.detener_tiempo();
+        if (opcion >= 0 && opcion <= 5 && tramoOpcion) {
+            double t_ms = tramoOpcion->transcurrido(); // Toda la opción, no la última subfase
             long mem_kb = monitor.obtener_memoria(); // lectura directa
             monitor.mostrar_estadistica("Opción " + std::to_string(opcion), t_ms, mem_kb);
         }
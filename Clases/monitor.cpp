@@ -1,6 +1,120 @@
 #include "monitor.h"
-#include <unistd.h> // sysconf
+#include <unistd.h> // sysconf, syscall, read, close
 #include <cstdio>   // FILE, fscanf
+#include <cerrno>
+#include <cstdint>
+#include <cstring>  // memset, strerror
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+// Eventos medidos, en el orden de los campos de ContadoresHW
+struct EventoHW {
+    const char* nombre;
+    std::uint32_t tipo;
+    std::uint64_t config;
+};
+
+static const EventoHW EVENTOS[] = {
+    {"ciclos", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instrucciones", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"fallos L1d", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                                       (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {"fallos LLC", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"fallos de salto", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+Monitor::ContadoresHW::ContadoresHW()
+    : ciclos(-1), instrucciones(-1), fallosL1(-1), fallosLLC(-1), fallosRamas(-1) {}
+
+bool Monitor::ContadoresHW::alguno() const {
+    return ciclos >= 0 || instrucciones >= 0 || fallosL1 >= 0 || fallosLLC >= 0 || fallosRamas >= 0;
+}
+
+// Acceso por posición a los campos de ContadoresHW (mismo orden que EVENTOS)
+static long long& campo(Monitor::ContadoresHW& c, int i) {
+    long long* campos[] = {&c.ciclos, &c.instrucciones, &c.fallosL1, &c.fallosLLC, &c.fallosRamas};
+    return *campos[i];
+}
+
+static long long campo(const Monitor::ContadoresHW& c, int i) {
+    return campo(const_cast<Monitor::ContadoresHW&>(c), i);
+}
+
+Monitor::Monitor() : marcaRastreo(), origen(std::chrono::high_resolution_clock::now()) {}
+
+// Identificador del hilo para la traza (el mismo que muestran top y perf)
+static long hiloActual() {
+    static thread_local long tid = static_cast<long>(syscall(SYS_gettid));
+    return tid;
+}
+
+Monitor::~Monitor() {
+    descartarRastreo(marcaRastreo);
+    desactivar_contadores();
+}
+
+/**
+ * Abre los contadores de hardware del hilo actual y de los hilos que cree.
+ *
+ * POR QUÉ: El tiempo y la RSS no dicen si una consulta está limitada por
+ *          fallos de caché o de predicción de saltos.
+ * CÓMO: Un perf_event_open por evento (solo espacio de usuario, para que
+ *       funcione con perf_event_paranoid = 2), inicialmente detenido y
+ *       heredable: la lectura suma los hilos del pool creados después, y
+ *       reiniciar/activar se aplica también a ellos.
+ * PARA QUÉ: Validar cambios de disposición en memoria como el almacén columnar.
+ * @return true si al menos un evento quedó disponible.
+ */
+bool Monitor::activar_contadores() {
+    desactivar_contadores();
+    int ultimoError = 0;
+    for (int i = 0; i < TOTAL_EVENTOS; ++i) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = EVENTOS[i].tipo;
+        attr.config = EVENTOS[i].config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = 1; // Incluye los hilos creados después (el pool)
+        // Tiempos para escalar si el kernel multiplexa los contadores
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        fdEventos[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fdEventos[i] < 0) ultimoError = errno;
+    }
+
+    for (int i = 0; i < TOTAL_EVENTOS; ++i) {
+        if (fdEventos[i] >= 0) {
+            errorContadores.clear();
+            return true;
+        }
+    }
+    errorContadores = std::string("perf_event_open: ") + std::strerror(ultimoError);
+    return false;
+}
+
+void Monitor::desactivar_contadores() {
+    for (int i = 0; i < TOTAL_EVENTOS; ++i) {
+        if (fdEventos[i] >= 0) close(fdEventos[i]);
+        fdEventos[i] = -1;
+    }
+    errorContadores = "desactivados";
+}
+
+std::string Monitor::estado_contadores() const {
+    std::string disponibles;
+    for (int i = 0; i < TOTAL_EVENTOS; ++i) {
+        if (fdEventos[i] >= 0) {
+            if (!disponibles.empty()) disponibles += ", ";
+            disponibles += EVENTOS[i].nombre;
+        }
+    }
+    return disponibles.empty() ? "no disponibles (" + errorContadores + ")" : disponibles;
+}
 
 /**
  * Inicia el cronómetro.
@@ -10,6 +124,14 @@
  * PARA QUÉ: Poder calcular la duración después.
  */
 void Monitor::iniciar_tiempo() {
+    for (int i = 0; i < TOTAL_EVENTOS; ++i) {
+        if (fdEventos[i] >= 0) {
+            ioctl(fdEventos[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fdEventos[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    descartarRastreo(marcaRastreo); // Un iniciar_tiempo sin detener_tiempo previo
+    marcaRastreo = iniciarRastreo();
     inicio = std::chrono::high_resolution_clock::now();
 }
 
@@ -23,6 +145,23 @@ void Monitor::iniciar_tiempo() {
  */
 double Monitor::detener_tiempo() {
     auto fin = std::chrono::high_resolution_clock::now();
+    ultimasAsignaciones = medirRastreo(marcaRastreo);
+
+    // Lectura de contadores: valor, tiempo habilitado y tiempo en ejecución
+    ultimosContadores = ContadoresHW();
+    for (int i = 0; i < TOTAL_EVENTOS; ++i) {
+        if (fdEventos[i] < 0) continue;
+        ioctl(fdEventos[i], PERF_EVENT_IOC_DISABLE, 0);
+        std::uint64_t lectura[3];
+        if (read(fdEventos[i], lectura, sizeof(lectura)) != static_cast<ssize_t>(sizeof(lectura)) ||
+            lectura[2] == 0) {
+            continue;
+        }
+        // Escala si el evento no estuvo en la PMU todo el tiempo
+        campo(ultimosContadores, i) = static_cast<long long>(
+            lectura[2] < lectura[1] ? static_cast<double>(lectura[0]) * lectura[1] / lectura[2] : lectura[0]);
+    }
+
     std::chrono::duration<double, std::milli> duracion = fin - inicio;
     return duracion.count();
 }
@@ -64,7 +203,12 @@ long Monitor::obtener_memoria() {
  * PARA QUÉ: Tener un histórico de rendimiento.
  */
 void Monitor::registrar(const std::string& operacion, double tiempo, long memoria) {
-    registros.push_back({operacion, tiempo, memoria});
+    // Los contadores de la última medición pertenecen a esta operación
+    registros.push_back({operacion, tiempo, memoria, ultimosContadores, ultimasAsignaciones});
+    // En la traza empieza en el último iniciar_tiempo(); la RSS se muestrea al final
+    agregar_evento(operacion, "operacion", inicio, tiempo, -1, obtener_memoria());
+    ultimosContadores = ContadoresHW();
+    ultimasAsignaciones = ConteoAsignaciones();
     total_tiempo += tiempo;
     if (memoria > max_memoria) {
         max_memoria = memoria;
@@ -96,9 +240,149 @@ void Monitor::mostrar_resumen() {
     for (const auto& reg : registros) {
         std::cout << "\n" << reg.operacion << ": "
                   << reg.tiempo << " ms, " << reg.memoria << " KB";
+        const ContadoresHW& c = reg.contadores;
+        if (c.alguno()) {
+            if (c.ciclos > 0 && c.instrucciones >= 0) {
+                std::cout << " | IPC " << static_cast<double>(c.instrucciones) / c.ciclos;
+            }
+            for (int i = 0; i < TOTAL_EVENTOS; ++i) {
+                const long long v = campo(c, i);
+                if (v >= 0) std::cout << " | " << EVENTOS[i].nombre << " " << v;
+            }
+        }
+        if (rastreoActivo()) {
+            const ConteoAsignaciones& a = reg.asignaciones;
+            std::cout << " | " << a.asignaciones << " asignaciones, " << a.bytes / 1024
+                      << " KB asignados, pico heap +" << a.picoVivo / 1024 << " KB";
+        }
     }
     std::cout << "\nTotal tiempo: " << total_tiempo << " ms";
     std::cout << "\nMemoria máxima: " << max_memoria << " KB\n";
+    mostrar_tramos();
+}
+
+// Tramo abierto más interno de cada hilo (padre de los que se abran después)
+static thread_local Monitor::Tramo* tramoActual = nullptr;
+
+/**
+ * Abre un tramo de medición.
+ *
+ * POR QUÉ: Un solo cronómetro no permite medir subfases ni anidarlas.
+ * CÓMO: Toma tiempo, RSS y marca de asignaciones iniciales y se registra como
+ *       hijo del tramo abierto en este hilo.
+ * PARA QUÉ: Ver qué subfase de una opción es el cuello de botella.
+ */
+Monitor::Tramo::Tramo(Monitor& monitor, const std::string& nombre)
+    : monitor(monitor), nombre(nombre), indice(0), padre(tramoActual), abierto(true) {
+    indice = monitor.abrir_tramo(nombre, padre ? padre->indice : SIN_PADRE);
+    memoriaInicio = monitor.obtener_memoria();
+    marcaRastreo = iniciarRastreo();
+    tramoActual = this;
+    inicio = std::chrono::high_resolution_clock::now();
+    monitor.agregar_evento(std::string(), nullptr, inicio, 0, -1, memoriaInicio); // Solo la muestra de RSS
+}
+
+Monitor::Tramo::~Tramo() {
+    cerrar();
+}
+
+/**
+ * Cierra el tramo y acumula su duración (solo la primera vez).
+ *
+ * POR QUÉ: Algunas fases terminan antes que el bloque que las contiene.
+ * CÓMO: Calcula tiempo, variación de RSS y asignaciones, y restaura el tramo padre.
+ * PARA QUÉ: Cerrar fases consecutivas dentro del mismo bloque.
+ */
+void Monitor::Tramo::cerrar() {
+    if (!abierto) return;
+    abierto = false;
+    const double ms = transcurrido();
+    const ConteoAsignaciones asignaciones = medirRastreo(marcaRastreo);
+    const long memoriaFinal = monitor.obtener_memoria();
+    if (tramoActual == this) tramoActual = padre;
+    monitor.cerrar_tramo(indice, ms, memoriaFinal - memoriaInicio, asignaciones);
+    monitor.agregar_evento(nombre, "tramo", inicio, ms, -1, memoriaFinal);
+}
+
+double Monitor::Tramo::transcurrido() const {
+    std::chrono::duration<double, std::milli> duracion = std::chrono::high_resolution_clock::now() - inicio;
+    return duracion.count();
+}
+
+std::size_t Monitor::abrir_tramo(const std::string& nombre, std::size_t padre) {
+    std::lock_guard<std::mutex> guarda(cerrojoTramos);
+    const std::pair<std::size_t, std::string> clave(padre, nombre);
+    std::map<std::pair<std::size_t, std::string>, std::size_t>::const_iterator it = indiceTramos.find(clave);
+    if (it != indiceTramos.end()) return it->second;
+
+    EstadisticaTramo e;
+    e.nombre = nombre;
+    e.padre = padre;
+    e.profundidad = padre == SIN_PADRE ? 0 : tramos[padre].profundidad + 1;
+    e.conteo = 0;
+    e.total = e.minimo = e.maximo = 0;
+    e.memoria = e.memoriaMaxima = 0;
+    e.asignaciones = e.bytesAsignados = 0;
+    e.picoHeap = 0;
+    tramos.push_back(e);
+    indiceTramos[clave] = tramos.size() - 1;
+    return tramos.size() - 1;
+}
+
+void Monitor::cerrar_tramo(std::size_t indice, double tiempo, long memoria,
+                           const ConteoAsignaciones& asignaciones) {
+    std::lock_guard<std::mutex> guarda(cerrojoTramos);
+    EstadisticaTramo& e = tramos[indice];
+    if (e.conteo == 0 || tiempo < e.minimo) e.minimo = tiempo;
+    if (e.conteo == 0 || tiempo > e.maximo) e.maximo = tiempo;
+    if (e.conteo == 0 || memoria > e.memoriaMaxima) e.memoriaMaxima = memoria;
+    if (e.conteo == 0 || asignaciones.picoVivo > e.picoHeap) e.picoHeap = asignaciones.picoVivo;
+    e.total += tiempo;
+    e.memoria += memoria;
+    e.asignaciones += asignaciones.asignaciones;
+    e.bytesAsignados += asignaciones.bytes;
+    ++e.conteo;
+}
+
+/**
+ * Muestra el árbol de tramos acumulados.
+ *
+ * POR QUÉ: Los registros planos no muestran qué subfase domina.
+ * CÓMO: Recorre los tramos de cada padre en orden de apertura, con sangría.
+ * PARA QUÉ: Localizar cuellos de botella dentro de una opción del menú.
+ */
+void Monitor::mostrar_tramos() {
+    std::lock_guard<std::mutex> guarda(cerrojoTramos);
+    if (tramos.empty()) return;
+
+    std::cout << "\n=== TRAMOS (veces | total | mín | máx ms | Δmemoria KB";
+    if (rastreoActivo()) std::cout << " | asignaciones | KB asignados | pico heap KB";
+    std::cout << ") ===";
+    // Los hijos se imprimen bajo su padre aunque se hayan abierto más tarde
+    std::vector<std::vector<std::size_t>> hijos(tramos.size());
+    std::vector<std::size_t> raices;
+    for (std::size_t i = 0; i < tramos.size(); ++i) {
+        if (tramos[i].padre == SIN_PADRE) raices.push_back(i);
+        else hijos[tramos[i].padre].push_back(i);
+    }
+
+    std::vector<std::size_t> pendientes(raices.rbegin(), raices.rend());
+    while (!pendientes.empty()) {
+        const std::size_t i = pendientes.back();
+        pendientes.pop_back();
+        const EstadisticaTramo& e = tramos[i];
+        if (e.conteo > 0) {
+            std::cout << "\n" << std::string(2 * e.profundidad, ' ') << e.nombre << ": "
+                      << e.conteo << " | " << e.total << " | " << e.minimo << " | " << e.maximo
+                      << " | " << e.memoria;
+            if (rastreoActivo()) {
+                std::cout << " | " << e.asignaciones << " | " << e.bytesAsignados / 1024
+                          << " | +" << e.picoHeap / 1024;
+            }
+        }
+        pendientes.insert(pendientes.end(), hijos[i].rbegin(), hijos[i].rend());
+    }
+    std::cout << "\n";
 }
 
 /**
@@ -115,10 +399,125 @@ void Monitor::exportar_csv(const std::string& nombre_archivo) {
         std::cerr << "Error al abrir archivo: " << nombre_archivo << std::endl;
         return;
     }
-    archivo << "Operacion,Tiempo(ms),Memoria(KB)\n";
+    archivo << "Operacion,Tiempo(ms),Memoria(KB),Ciclos,Instrucciones,FallosL1d,FallosLLC,FallosSalto,"
+               "Asignaciones,BytesAsignados,PicoHeap(B)\n";
     for (const auto& reg : registros) {
-        archivo << reg.operacion << "," << reg.tiempo << "," << reg.memoria << "\n";
+        archivo << reg.operacion << "," << reg.tiempo << "," << reg.memoria;
+        // Campo vacío si el evento no estuvo disponible
+        const ContadoresHW& c = reg.contadores;
+        for (int i = 0; i < TOTAL_EVENTOS; ++i) {
+            archivo << ",";
+            if (campo(c, i) >= 0) archivo << campo(c, i);
+        }
+        if (rastreoActivo()) {
+            archivo << "," << reg.asignaciones.asignaciones << "," << reg.asignaciones.bytes
+                    << "," << reg.asignaciones.picoVivo;
+        } else {
+            archivo << ",,,";
+        }
+        archivo << "\n";
     }
     archivo.close();
     std::cout << "Estadísticas exportadas a " << nombre_archivo << "\n";
-}
\ No newline at end of file
+}
+
+long long Monitor::microsegundos(std::chrono::high_resolution_clock::time_point t) const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(t - origen).count();
+}
+
+/**
+ * Guarda un intervalo y una muestra de RSS para la traza.
+ *
+ * POR QUÉ: La traza necesita instantes absolutos e hilo, que las estadísticas
+ *          acumuladas no conservan.
+ * CÓMO: Bajo cerrojoTramos, hasta MAX_EVENTOS_TRAZA; el resto solo se cuenta.
+ * PARA QUÉ: Exportar la sesión completa con exportar_traza().
+ */
+void Monitor::agregar_evento(const std::string& nombre, const char* categoria,
+                             std::chrono::high_resolution_clock::time_point desde, double ms,
+                             long long argumento, long memoria) {
+    const long long instante = microsegundos(desde);
+    const long hilo = hiloActual();
+    std::lock_guard<std::mutex> guarda(cerrojoTramos);
+    if (eventosTraza.size() + muestrasMemoria.size() >= MAX_EVENTOS_TRAZA) {
+        ++eventosDescartados;
+        return;
+    }
+    if (categoria) {
+        EventoTraza e = {nombre, categoria, hilo, instante, static_cast<long long>(ms * 1000), argumento};
+        eventosTraza.push_back(e);
+    }
+    if (memoria >= 0) {
+        MuestraMemoria m = {categoria ? instante + static_cast<long long>(ms * 1000) : instante, memoria};
+        muestrasMemoria.push_back(m);
+    }
+}
+
+void Monitor::trazar(const char* nombre, std::chrono::high_resolution_clock::time_point desde,
+                     std::chrono::high_resolution_clock::time_point hasta, long long argumento) {
+    std::chrono::duration<double, std::milli> duracion = hasta - desde;
+    agregar_evento(nombre, "tarea", desde, duracion.count(), argumento, -1);
+}
+
+// Texto como cadena JSON (comillas, barras y caracteres de control escapados)
+static void escribirCadenaJSON(std::ofstream& archivo, const std::string& texto) {
+    archivo << '"';
+    for (std::size_t i = 0; i < texto.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(texto[i]);
+        if (c == '"' || c == '\\') {
+            archivo << '\\' << static_cast<char>(c);
+        } else if (c < 0x20) {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+            archivo << escape;
+        } else {
+            archivo << static_cast<char>(c);
+        }
+    }
+    archivo << '"';
+}
+
+/**
+ * Exporta la línea de tiempo en formato Chrome Trace Event (JSON).
+ *
+ * POR QUÉ: El CSV es una lista plana sin instantes ni hilos; con consultas
+ *          paralelas interesa ver la ocupación de cada hilo y los rezagados.
+ * CÓMO: Un evento completo ("X") por operación, tramo y tarea del pool, con
+ *       su hilo, y una pista de contador ("C") con la RSS muestreada.
+ * PARA QUÉ: Abrir la sesión en chrome://tracing o en ui.perfetto.dev.
+ * @param nombre_archivo Nombre del archivo JSON (por defecto "traza.json")
+ */
+void Monitor::exportar_traza(const std::string& nombre_archivo) {
+    std::ofstream archivo(nombre_archivo);
+    if (!archivo) {
+        std::cerr << "Error al abrir archivo: " << nombre_archivo << std::endl;
+        return;
+    }
+
+    std::lock_guard<std::mutex> guarda(cerrojoTramos);
+    const long pid = static_cast<long>(getpid());
+    archivo << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    // El hilo principal tiene TID == PID
+    archivo << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << pid
+            << ",\"args\":{\"name\":\"Principal\"}}";
+    for (std::size_t i = 0; i < eventosTraza.size(); ++i) {
+        const EventoTraza& e = eventosTraza[i];
+        archivo << ",\n{\"name\":";
+        escribirCadenaJSON(archivo, e.nombre);
+        archivo << ",\"cat\":\"" << e.categoria << "\",\"ph\":\"X\",\"pid\":" << pid
+                << ",\"tid\":" << e.hilo << ",\"ts\":" << e.inicio << ",\"dur\":" << e.duracion;
+        if (e.argumento >= 0) archivo << ",\"args\":{\"bloque\":" << e.argumento << "}";
+        archivo << "}";
+    }
+    for (std::size_t i = 0; i < muestrasMemoria.size(); ++i) {
+        archivo << ",\n{\"name\":\"RSS (KB)\",\"ph\":\"C\",\"pid\":" << pid
+                << ",\"ts\":" << muestrasMemoria[i].instante
+                << ",\"args\":{\"rss\":" << muestrasMemoria[i].memoria << "}}";
+    }
+    archivo << "\n]}\n";
+    archivo.close();
+
+    std::cout << "Traza exportada a " << nombre_archivo << " (" << eventosTraza.size() << " eventos";
+    if (eventosDescartados > 0) std::cout << ", " << eventosDescartados << " descartados";
+    std::cout << ")\n";
+}
@@ -2,11 +2,17 @@
 #define MONITOR_H
 
 #include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 #include <iostream>
 #include <fstream>
 
+#include "rastreo.h"
+
 /**
  * Clase para monitorear el rendimiento (tiempo y memoria).
  * 
@@ -16,6 +22,29 @@
  */
 class Monitor {
 public:
+    Monitor();
+    ~Monitor();
+
+    // Contadores de hardware de una operación; -1 si el evento no está disponible
+    struct ContadoresHW {
+        long long ciclos;
+        long long instrucciones;
+        long long fallosL1;     // Fallos de lectura en caché L1 de datos
+        long long fallosLLC;    // Fallos en la caché de último nivel
+        long long fallosRamas;  // Predicciones de salto fallidas
+
+        ContadoresHW();
+        bool alguno() const;    // true si al menos un evento se midió
+    };
+
+    // Abre los contadores con perf_event_open. Si el kernel no los permite
+    // (perf_event_paranoid, contenedores, VMs sin PMU) se sigue sin ellos.
+    // Cuentan el hilo que llama y los hilos que cree después (attr.inherit):
+    // activarlos antes de crear el pool para incluir el trabajo de sus hilos.
+    bool activar_contadores();
+    void desactivar_contadores();
+    std::string estado_contadores() const; // Eventos disponibles o motivo del fallo
+
     void iniciar_tiempo();
     double detener_tiempo();
     long obtener_memoria();
@@ -24,6 +53,42 @@ public:
     void mostrar_estadistica(const std::string& operacion, double tiempo, long memoria);
     void mostrar_resumen();
     void exportar_csv(const std::string& nombre_archivo = "estadisticas.csv");
+    // Línea de tiempo en formato Chrome Trace Event (chrome://tracing, Perfetto)
+    void exportar_traza(const std::string& nombre_archivo = "traza.json");
+
+    // Añade a la traza un intervalo ya medido en el hilo que llama (p. ej. una
+    // tarea del pool). No se acumula en los tramos. argumento < 0 = sin argumento.
+    void trazar(const char* nombre, std::chrono::high_resolution_clock::time_point desde,
+                std::chrono::high_resolution_clock::time_point hasta, long long argumento = -1);
+
+    /**
+     * Tramo de medición con alcance (RAII): mide desde su construcción hasta
+     * su destrucción (o cerrar()). Los tramos abiertos dentro de otro en el
+     * mismo hilo quedan como hijos; las repeticiones se acumulan.
+     */
+    class Tramo {
+    public:
+        Tramo(Monitor& monitor, const std::string& nombre);
+        ~Tramo();
+
+        void cerrar();               // Termina el tramo antes del fin del bloque
+        double transcurrido() const; // Milisegundos desde la apertura
+
+    private:
+        Tramo(const Tramo&);            // No copiable
+        Tramo& operator=(const Tramo&);
+
+        Monitor& monitor;
+        std::string nombre;  // Para el evento de la traza
+        std::size_t indice;  // Entrada en Monitor::tramos
+        Tramo* padre;        // Tramo abierto en este hilo al construir
+        std::chrono::high_resolution_clock::time_point inicio;
+        long memoriaInicio;
+        MarcaRastreo marcaRastreo; // Asignaciones al abrir (solo con `make RASTREO=1`)
+        bool abierto;
+    };
+
+    void mostrar_tramos(); // Árbol de tramos con conteo, total, mínimo y máximo
 
 private:
     // Estructura para almacenar métricas de una operación
@@ -31,12 +96,70 @@ private:
         std::string operacion; // Nombre de la operación
         double tiempo;         // Tiempo en milisegundos
         long memoria;          // Memoria en KB
+        ContadoresHW contadores; // Entre iniciar_tiempo y detener_tiempo
+        ConteoAsignaciones asignaciones; // Solo con `make RASTREO=1`
     };
+
+    static constexpr int TOTAL_EVENTOS = 5;
+    int fdEventos[TOTAL_EVENTOS] = {-1, -1, -1, -1, -1}; // Descriptores perf (-1 = cerrado)
+    std::string errorContadores;     // Motivo si ningún evento pudo abrirse
+    ContadoresHW ultimosContadores;  // Última medición, pendiente de registrar
+    MarcaRastreo marcaRastreo;                 // Totales de asignación al iniciar_tiempo
+    ConteoAsignaciones ultimasAsignaciones;    // Pendiente de registrar, como los contadores
     
     std::chrono::high_resolution_clock::time_point inicio; // Punto de inicio del cronómetro
     std::vector<Registro> registros; // Historial de registros
     double total_tiempo = 0;         // Tiempo total acumulado
     long max_memoria = 0;            // Máximo de memoria utilizado
+
+    // Acumulado de todas las ejecuciones de un tramo (mismo nombre y padre)
+    struct EstadisticaTramo {
+        std::string nombre;
+        std::size_t padre;      // Índice del tramo padre o SIN_PADRE
+        int profundidad;        // 0 para tramos sin padre
+        std::size_t conteo;     // Veces que se cerró
+        double total, minimo, maximo; // Milisegundos
+        long memoria;           // Suma de variaciones de RSS (KB)
+        long memoriaMaxima;     // Mayor variación en una ejecución (KB)
+        std::uint64_t asignaciones;   // Suma de asignaciones (solo con `make RASTREO=1`)
+        std::uint64_t bytesAsignados; // Suma de bytes asignados
+        std::int64_t picoHeap;        // Mayor crecimiento del heap vivo en una ejecución
+    };
+    static constexpr std::size_t SIN_PADRE = static_cast<std::size_t>(-1);
+
+    std::size_t abrir_tramo(const std::string& nombre, std::size_t padre);
+    void cerrar_tramo(std::size_t indice, double tiempo, long memoria,
+                      const ConteoAsignaciones& asignaciones);
+
+    std::vector<EstadisticaTramo> tramos; // En orden de primera apertura
+    std::map<std::pair<std::size_t, std::string>, std::size_t> indiceTramos; // (padre, nombre) -> índice
+    std::mutex cerrojoTramos; // Los tramos pueden cerrarse desde hilos del pool
+
+    // Intervalo de la línea de tiempo (evento "X" de Chrome Trace)
+    struct EventoTraza {
+        std::string nombre;
+        const char* categoria;  // "operacion", "tramo" o "tarea"
+        long hilo;              // TID del sistema
+        long long inicio;       // Microsegundos desde 'origen'
+        long long duracion;     // Microsegundos
+        long long argumento;    // -1 = sin argumento
+    };
+    // Muestra de RSS para la pista de contador (evento "C")
+    struct MuestraMemoria {
+        long long instante;     // Microsegundos desde 'origen'
+        long memoria;           // KB
+    };
+    static constexpr std::size_t MAX_EVENTOS_TRAZA = 1 << 20; // Tope de memoria de la traza
+
+    long long microsegundos(std::chrono::high_resolution_clock::time_point t) const;
+    void agregar_evento(const std::string& nombre, const char* categoria,
+                        std::chrono::high_resolution_clock::time_point desde, double ms,
+                        long long argumento, long memoria); // memoria < 0 = sin muestra
+
+    std::chrono::high_resolution_clock::time_point origen; // Creación del monitor
+    std::vector<EventoTraza> eventosTraza;    // Protegidos por cerrojoTramos
+    std::vector<MuestraMemoria> muestrasMemoria;
+    std::size_t eventosDescartados = 0;       // Por encima de MAX_EVENTOS_TRAZA
 };
 
 #endif // MONITOR_H
\ No newline at end of file
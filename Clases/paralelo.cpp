@@ -0,0 +1,334 @@
+#include "paralelo.h"
+#include <stdexcept>
+#include "ciudades.h"
+#include "monitor.h"
+
+// ============================== Pool de hilos ==============================
+
+PoolHilos::PoolHilos(unsigned hilos)
+    : totalHilos(hilos), monitor(nullptr), pendientes(0), detener(false) {
+    if (totalHilos == 0) totalHilos = std::thread::hardware_concurrency();
+    if (totalHilos == 0) totalHilos = 1;
+
+    // Con un solo hilo trabaja el que llama; no hace falta crear trabajadores
+    if (totalHilos > 1) {
+        for (unsigned i = 0; i < totalHilos; ++i) {
+            trabajadores.push_back(std::thread(&PoolHilos::trabajar, this));
+        }
+    }
+}
+
+PoolHilos::~PoolHilos() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        detener = true;
+    }
+    hayTrabajo.notify_all();
+    for (std::size_t i = 0; i < trabajadores.size(); ++i) trabajadores[i].join();
+}
+
+unsigned PoolHilos::getHilos() const { return totalHilos; }
+
+void PoolHilos::setMonitor(Monitor* monitor) { this->monitor = monitor; }
+
+void PoolHilos::ejecutarTarea(const std::function<void(std::size_t)>& tarea, std::size_t t) {
+    if (!monitor) {
+        tarea(t);
+        return;
+    }
+    const std::chrono::high_resolution_clock::time_point desde = std::chrono::high_resolution_clock::now();
+    try {
+        tarea(t);
+    } catch (...) {
+        monitor->trazar("Tarea", desde, std::chrono::high_resolution_clock::now(), static_cast<long long>(t));
+        throw;
+    }
+    monitor->trazar("Tarea", desde, std::chrono::high_resolution_clock::now(), static_cast<long long>(t));
+}
+
+void PoolHilos::trabajar() {
+    for (;;) {
+        std::function<void()> trabajo;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            hayTrabajo.wait(lock, [this] { return detener || !cola.empty(); });
+            if (cola.empty()) return; // detener y sin trabajo pendiente
+            trabajo = std::move(cola.front());
+            cola.pop();
+        }
+
+        trabajo();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pendientes == 0) terminoTrabajo.notify_all();
+    }
+}
+
+void PoolHilos::paraCada(std::size_t tareas, const std::function<void(std::size_t)>& tarea) {
+    if (tareas == 0) return;
+
+    if (trabajadores.empty()) {
+        for (std::size_t t = 0; t < tareas; ++t) ejecutarTarea(tarea, t);
+        return;
+    }
+
+    // La primera excepción de cualquier tarea se guarda y se relanza al final
+    std::exception_ptr error;
+    std::mutex mutexError;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t t = 0; t < tareas; ++t) {
+            cola.push([this, t, &tarea, &error, &mutexError]() {
+                try {
+                    ejecutarTarea(tarea, t);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lockError(mutexError);
+                    if (!error) error = std::current_exception();
+                }
+            });
+        }
+        pendientes += tareas;
+    }
+    hayTrabajo.notify_all();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        terminoTrabajo.wait(lock, [this] { return pendientes == 0; });
+    }
+
+    if (error) std::rethrow_exception(error);
+}
+
+// ============================== Bloques ==============================
+
+// Tamaño mínimo de bloque: por debajo, el costo de repartir supera al de recorrer
+static const std::size_t FILAS_MINIMAS_POR_BLOQUE = 16384;
+
+Bloques::Bloques(std::size_t total, unsigned hilos) : n(total) {
+    // Varios bloques por hilo para equilibrar la carga
+    cantidad = static_cast<std::size_t>(hilos) * 4;
+    std::size_t maximo = (n + FILAS_MINIMAS_POR_BLOQUE - 1) / FILAS_MINIMAS_POR_BLOQUE;
+    if (cantidad > maximo) cantidad = maximo;
+    if (cantidad == 0) cantidad = 1;
+}
+
+std::size_t Bloques::inicio(std::size_t b) const { return n * b / cantidad; }
+std::size_t Bloques::fin(std::size_t b) const { return n * (b + 1) / cantidad; }
+
+// ============================== Extremos ==============================
+
+// Posición del mejor elemento según 'menor'. Cada bloque conserva su primer
+// mejor y la mezcla, en orden de bloques, solo reemplaza con desigualdad
+// estricta: igual desempate que std::max_element / std::min_element.
+template <typename Menor>
+static std::size_t mejorParalelo(const std::vector<Persona>& personas, PoolHilos& pool, Menor menor) {
+    if (personas.empty()) {
+        throw std::runtime_error("La lista está vacía");
+    }
+
+    Bloques bloques(personas.size(), pool.getHilos());
+    std::vector<std::size_t> parciales(bloques.cantidad);
+
+    pool.paraCada(bloques.cantidad, [&](std::size_t b) {
+        std::size_t mejor = bloques.inicio(b);
+        for (std::size_t i = mejor + 1, fin = bloques.fin(b); i < fin; ++i) {
+            if (menor(personas[mejor], personas[i])) mejor = i;
+        }
+        parciales[b] = mejor;
+    });
+
+    std::size_t mejor = parciales[0];
+    for (std::size_t b = 1; b < parciales.size(); ++b) {
+        if (menor(personas[mejor], personas[parciales[b]])) mejor = parciales[b];
+    }
+    return mejor;
+}
+
+void personaMaxLongevaParalelo(const std::vector<Persona>& personas, Persona& longeva, PoolHilos& pool) {
+    // "Mejor" = fecha empaquetada más antigua
+    longeva = personas[mejorParalelo(personas, pool,
+                [](const Persona& a, const Persona& b) {
+                    return b.getFechaEmpaquetada() < a.getFechaEmpaquetada();
+                })];
+}
+
+void personaMaxPatrimonioParalelo(const std::vector<Persona>& personas, Persona& maxPatrimonio, PoolHilos& pool) {
+    maxPatrimonio = personas[mejorParalelo(personas, pool,
+                    [](const Persona& a, const Persona& b) {
+                        return a.getPatrimonio() < b.getPatrimonio();
+                    })];
+}
+
+void personaMinPatrimonioParalelo(const std::vector<Persona>& personas, Persona& minPatrimonio, PoolHilos& pool) {
+    minPatrimonio = personas[mejorParalelo(personas, pool,
+                    [](const Persona& a, const Persona& b) {
+                        return b.getPatrimonio() < a.getPatrimonio();
+                    })];
+}
+
+void personaMaxDeudaParalelo(const std::vector<Persona>& personas, Persona& maxDeuda, PoolHilos& pool) {
+    maxDeuda = personas[mejorParalelo(personas, pool,
+            [](const Persona& a, const Persona& b) {
+                return a.getDeudas() < b.getDeudas();
+            })];
+}
+
+// ============================== Agrupaciones ==============================
+
+// Agrupa índices en 'totalGrupos' cubetas según clave(persona) (-1 = descartar).
+// Pasada 1: cada bloque cuenta cuántas filas aporta a cada grupo.
+// Pasada 2: con esos conteos cada bloque sabe en qué posición de cada grupo
+// escribe, así que los índices quedan en el mismo orden que en secuencial.
+template <typename Clave>
+static void agruparParalelo(const std::vector<Persona>& personas, std::size_t totalGrupos,
+                            std::vector<std::vector<std::uint32_t>>& cubetas,
+                            PoolHilos& pool, Clave clave) {
+    if (personas.size() > UINT32_MAX) {
+        throw std::length_error("Demasiadas personas para índices de 32 bits");
+    }
+
+    Bloques bloques(personas.size(), pool.getHilos());
+    // conteos[b * totalGrupos + g]: filas del bloque b en el grupo g
+    std::vector<std::size_t> conteos(bloques.cantidad * totalGrupos, 0);
+
+    pool.paraCada(bloques.cantidad, [&](std::size_t b) {
+        std::size_t* conteo = &conteos[b * totalGrupos];
+        for (std::size_t i = bloques.inicio(b), fin = bloques.fin(b); i < fin; ++i) {
+            int g = clave(personas[i]);
+            if (g >= 0) ++conteo[g];
+        }
+    });
+
+    // Prefijos: los conteos pasan a ser la posición inicial de cada bloque
+    cubetas.assign(totalGrupos, std::vector<std::uint32_t>());
+    for (std::size_t g = 0; g < totalGrupos; ++g) {
+        std::size_t acumulado = 0;
+        for (std::size_t b = 0; b < bloques.cantidad; ++b) {
+            std::size_t c = conteos[b * totalGrupos + g];
+            conteos[b * totalGrupos + g] = acumulado;
+            acumulado += c;
+        }
+        cubetas[g].resize(acumulado);
+    }
+
+    pool.paraCada(bloques.cantidad, [&](std::size_t b) {
+        std::size_t* posicion = &conteos[b * totalGrupos];
+        for (std::size_t i = bloques.inicio(b), fin = bloques.fin(b); i < fin; ++i) {
+            int g = clave(personas[i]);
+            if (g >= 0) cubetas[g][posicion[g]++] = static_cast<std::uint32_t>(i);
+        }
+    });
+}
+
+// Añade cada cubeta al grupo 'nombres[g]' del mapa (al final si ya existía)
+static void volcarEnMapa(std::vector<std::vector<std::uint32_t>>& cubetas,
+                         const std::vector<std::string>& nombres,
+                         std::map<std::string, std::vector<std::uint32_t>>& grupos,
+                         bool incluirVacias) {
+    for (std::size_t g = 0; g < cubetas.size(); ++g) {
+        if (cubetas[g].empty() && !incluirVacias) continue;
+
+        std::vector<std::uint32_t>& destino = grupos[nombres[g]];
+        if (destino.empty()) {
+            destino.swap(cubetas[g]);
+        } else {
+            destino.insert(destino.end(), cubetas[g].begin(), cubetas[g].end());
+        }
+    }
+}
+
+static std::vector<std::string> nombresDeCiudades(std::size_t total) {
+    std::vector<std::string> nombres;
+    for (std::size_t c = 0; c < total; ++c) {
+        nombres.push_back(nombreCiudad(static_cast<CodigoCiudad>(c)));
+    }
+    return nombres;
+}
+
+void agruparPorCiudadParalelo(const std::vector<Persona>& personas,
+                              std::map<std::string, std::vector<std::uint32_t>>& grupos, PoolHilos& pool) {
+    const std::size_t total = totalCiudades();
+    std::vector<std::vector<std::uint32_t>> cubetas;
+    agruparParalelo(personas, total, cubetas, pool,
+                    [](const Persona& p) { return static_cast<int>(p.getCodigoCiudad()); });
+    volcarEnMapa(cubetas, nombresDeCiudades(total), grupos, false);
+}
+
+void agruparPorDeclaracionParalelo(const std::vector<Persona>& personas,
+                                   std::map<std::string, std::vector<std::uint32_t>>& grupos, PoolHilos& pool) {
+    std::vector<std::vector<std::uint32_t>> cubetas;
+    agruparParalelo(personas, 3, cubetas, pool,
+                    [](const Persona& p) { return Persona::indiceGrupoDIAN(p.getId()); });
+
+    // Igual que la versión secuencial, los grupos A, B y C siempre existen
+    std::vector<std::string> letras;
+    letras.push_back("A"); letras.push_back("B"); letras.push_back("C");
+    volcarEnMapa(cubetas, letras, grupos, true);
+}
+
+void declarantePorCiudadParalelo(const std::vector<Persona>& personas,
+                                 std::map<std::string, std::vector<std::uint32_t>>& grupos, PoolHilos& pool) {
+    const std::size_t total = totalCiudades();
+
+    std::vector<std::vector<std::uint32_t>> cubetas;
+    agruparParalelo(personas, total, cubetas, pool,
+                    [](const Persona& p) {
+                        return p.getDeclaranteRenta() ? static_cast<int>(p.getCodigoCiudad()) : -1;
+                    });
+
+    // Igual que la versión secuencial, toda ciudad presente aparece aunque no
+    // tenga declarantes: cada bloque marca las ciudades que ve
+    Bloques bloques(personas.size(), pool.getHilos());
+    std::vector<unsigned char> presentes(bloques.cantidad * total, 0);
+    pool.paraCada(bloques.cantidad, [&](std::size_t b) {
+        unsigned char* marca = &presentes[b * total];
+        for (std::size_t i = bloques.inicio(b), fin = bloques.fin(b); i < fin; ++i) {
+            marca[personas[i].getCodigoCiudad()] = 1;
+        }
+    });
+
+    std::vector<std::string> nombres = nombresDeCiudades(total);
+    for (std::size_t c = 0; c < total; ++c) {
+        for (std::size_t b = 0; b < bloques.cantidad; ++b) {
+            if (presentes[b * total + c]) {
+                grupos[nombres[c]];
+                break;
+            }
+        }
+    }
+    volcarEnMapa(cubetas, nombres, grupos, false);
+}
+
+// ============================== Reporte ==============================
+
+ReporteAnalitico generarReporteParalelo(const PersonaStore& store, PoolHilos& pool) {
+    Bloques bloques(store.size(), pool.getHilos());
+    std::vector<ReporteAnalitico> parciales(bloques.cantidad, reporteVacio());
+
+    pool.paraCada(bloques.cantidad, [&](std::size_t b) {
+        acumularRango(parciales[b], store, bloques.inicio(b), bloques.fin(b));
+    });
+
+    // Mezcla en orden de bloques para conservar el desempate por la primera fila
+    for (std::size_t b = 1; b < parciales.size(); ++b) {
+        mezclarReporte(parciales[0], parciales[b], store);
+    }
+    return parciales[0];
+}
+
+ReporteDinero generarReporteDineroParalelo(const PersonaStore& store, PoolHilos& pool) {
+    Bloques bloques(store.size(), pool.getHilos());
+    std::vector<ReporteDinero> parciales(bloques.cantidad, reporteDineroVacio());
+
+    pool.paraCada(bloques.cantidad, [&](std::size_t b) {
+        acumularDineroRango(parciales[b], store, bloques.inicio(b), bloques.fin(b));
+    });
+
+    // Sumas enteras: cualquier orden de mezcla da el mismo total
+    ReporteDinero reporte = reporteDineroVacio();
+    for (std::size_t b = 0; b < parciales.size(); ++b) {
+        mezclarReporteDinero(reporte, parciales[b]);
+    }
+    return reporte;
+}
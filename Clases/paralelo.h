@@ -0,0 +1,91 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "persona.h"
+#include "persona_store.h"
+#include "analitica.h"
+
+class Monitor;
+
+// Grupo fijo de hilos trabajadores que ejecuta bloques de un recorrido.
+// Con 1 hilo todo se ejecuta en el hilo que llama, sin crear trabajadores.
+class PoolHilos {
+public:
+    // hilos = 0 usa std::thread::hardware_concurrency()
+    explicit PoolHilos(unsigned hilos = 0);
+    ~PoolHilos();
+
+    unsigned getHilos() const;
+
+    // Ejecuta tarea(0..tareas-1) repartidas entre los hilos y espera a que
+    // terminen todas. Si alguna lanza una excepción, se relanza aquí.
+    void paraCada(std::size_t tareas, const std::function<void(std::size_t)>& tarea);
+
+    // Registra cada tarea en la traza del monitor (nullptr = sin traza)
+    void setMonitor(Monitor* monitor);
+
+private:
+    PoolHilos(const PoolHilos&);            // No copiable
+    PoolHilos& operator=(const PoolHilos&);
+
+    void trabajar();
+
+    void ejecutarTarea(const std::function<void(std::size_t)>& tarea, std::size_t t);
+
+    unsigned totalHilos;
+    Monitor* monitor;
+    std::vector<std::thread> trabajadores;
+    std::queue<std::function<void()>> cola;
+    std::mutex mutex;
+    std::condition_variable hayTrabajo;
+    std::condition_variable terminoTrabajo;
+    std::size_t pendientes;
+    bool detener;
+};
+
+// Reparto de [0, n) en bloques contiguos; el bloque b cubre [inicio(b), fin(b))
+struct Bloques {
+    std::size_t n;
+    std::size_t cantidad;
+
+    Bloques(std::size_t n, unsigned hilos);
+    std::size_t inicio(std::size_t b) const;
+    std::size_t fin(std::size_t b) const;
+};
+
+// --- Versiones paralelas de las consultas de Persona ---
+// Cada bloque calcula un resultado parcial y la mezcla respeta el orden de los
+// bloques, por lo que el resultado (incluido el desempate por la primera fila
+// y el orden dentro de cada grupo) es idéntico al de la versión secuencial.
+
+void personaMaxLongevaParalelo(const std::vector<Persona>& personas, Persona& longeva, PoolHilos& pool);
+void personaMaxPatrimonioParalelo(const std::vector<Persona>& personas, Persona& maxPatrimonio, PoolHilos& pool);
+void personaMinPatrimonioParalelo(const std::vector<Persona>& personas, Persona& minPatrimonio, PoolHilos& pool);
+void personaMaxDeudaParalelo(const std::vector<Persona>& personas, Persona& maxDeuda, PoolHilos& pool);
+
+void agruparPorCiudadParalelo(const std::vector<Persona>& personas,
+                              std::map<std::string, std::vector<std::uint32_t>>& grupos, PoolHilos& pool);
+void agruparPorDeclaracionParalelo(const std::vector<Persona>& personas,
+                                   std::map<std::string, std::vector<std::uint32_t>>& grupos, PoolHilos& pool);
+void declarantePorCiudadParalelo(const std::vector<Persona>& personas,
+                                 std::map<std::string, std::vector<std::uint32_t>>& grupos, PoolHilos& pool);
+
+// Reporte de una sola pasada con un reporte parcial por bloque
+ReporteAnalitico generarReporteParalelo(const PersonaStore& store, PoolHilos& pool);
+
+// Totales de dinero exactos con un reporte parcial por bloque
+ReporteDinero generarReporteDineroParalelo(const PersonaStore& store, PoolHilos& pool);
+
+#endif // PARALELO_H
@@ -1,35 +1,92 @@
 #include <iostream>
 #include <iomanip>  // Para formato de salida (setprecision, fixed)
-#include <ctime> // Para obtener la fecha actual
+#include <cstdio>  // snprintf para fechas
 #include <map>
 #include <cctype>
 #include <stdexcept>
 #include <algorithm>
+#include <utility>   // std::move
 #include "persona.h"
+#include "persona_store.h"
+#include "simd.h"
+#include "formateador.h"
 #include "generador.h"
 
 // Constructor por defecto
-Persona::Persona(){}
+Persona::Persona() : largoNombre(0) {}
 
 // Implementación del constructor
-Persona::Persona(std::string nom, std::string ape, std::string id,
+Persona::Persona(std::string_view nom, std::string_view ape, std::string id,
                  std::string ciudad, std::string fecha, double ingresos,
                  double patri, double deud, bool declara)
-    : nombre(nom), apellido(ape), id(id), ciudadNacimiento(ciudad),
-      fechaNacimiento(fecha), ingresosAnuales(ingresos), patrimonio(patri),
+    : id(convertirID(id)), ciudadNacimiento(codigoCiudad(ciudad)),
+      fechaNacimiento(empaquetarFecha(fecha)), ingresosAnuales(ingresos), patrimonio(patri),
       deudas(deud), declaranteRenta(declara)
 {
     // Inicialización mediante lista de inicialización para eficiencia
+    asignarTextos(nom, ape);
+}
+
+Persona::Persona(std::string_view nom, std::string_view ape, std::uint64_t id,
+                 CodigoCiudad ciudad, std::int32_t fecha, double ingresos,
+                 double patri, double deud, bool declara,
+                 std::pmr::memory_resource* recurso)
+    : textos(recurso), id(id), ciudadNacimiento(ciudad),
+      fechaNacimiento(fecha), ingresosAnuales(ingresos), patrimonio(patri),
+      deudas(deud), declaranteRenta(declara)
+{
+    asignarTextos(nom, ape);
+}
+
+Persona::Persona(const Persona& otra, const allocator_type& asignador)
+    : textos(otra.textos, asignador), id(otra.id), ciudadNacimiento(otra.ciudadNacimiento),
+      largoNombre(otra.largoNombre), fechaNacimiento(otra.fechaNacimiento),
+      ingresosAnuales(otra.ingresosAnuales), patrimonio(otra.patrimonio),
+      deudas(otra.deudas), declaranteRenta(otra.declaranteRenta)
+{
+}
+
+// Con el mismo recurso mueve el texto; con otro lo copia a 'asignador'
+Persona::Persona(Persona&& otra, const allocator_type& asignador)
+    : textos(std::move(otra.textos), asignador), id(otra.id), ciudadNacimiento(otra.ciudadNacimiento),
+      largoNombre(otra.largoNombre), fechaNacimiento(otra.fechaNacimiento),
+      ingresosAnuales(otra.ingresosAnuales), patrimonio(otra.patrimonio),
+      deudas(otra.deudas), declaranteRenta(otra.declaranteRenta)
+{
+}
+
+// Una sola reserva exacta para nombre y apellido
+void Persona::asignarTextos(std::string_view nom, std::string_view ape) {
+    if (nom.size() > 0xFFFF) throw std::length_error("Nombre demasiado largo");
+    textos.reserve(nom.size() + ape.size());
+    textos.assign(nom.data(), nom.size()).append(ape.data(), ape.size());
+    largoNombre = static_cast<std::uint16_t>(nom.size());
+}
+
+// Convierte un documento textual a número; solo se aceptan dígitos
+std::uint64_t Persona::convertirID(const std::string& texto) {
+    if (texto.empty() || texto.size() > 19) {
+        throw std::invalid_argument("ID inválido: " + texto);
+    }
+    std::uint64_t valor = 0;
+    for (std::size_t i = 0; i < texto.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(texto[i]);
+        if (!std::isdigit(c)) throw std::invalid_argument("ID inválido: " + texto);
+        valor = valor * 10 + (c - '0');
+    }
+    return valor;
 }
 
 // --- Implementación de getters ---
 // Devuelven valores de campos privados sin permitir modificación (const)
 
-std::string Persona::getNombre() const { return nombre; }
-std::string Persona::getApellido() const { return apellido; }
-std::string Persona::getId() const { return id; }
-std::string Persona::getCiudadNacimiento() const { return ciudadNacimiento; }
-std::string Persona::getFechaNacimiento() const { return fechaNacimiento; }
+std::string_view Persona::getNombre() const { return std::string_view(textos.data(), largoNombre); }
+std::string_view Persona::getApellido() const { return std::string_view(textos).substr(largoNombre); }
+std::uint64_t Persona::getId() const { return id; }
+const std::string& Persona::getCiudadNacimiento() const { return nombreCiudad(ciudadNacimiento); }
+CodigoCiudad Persona::getCodigoCiudad() const { return ciudadNacimiento; }
+std::string Persona::getFechaNacimiento() const { return formatearFecha(fechaNacimiento); }
+std::int32_t Persona::getFechaEmpaquetada() const { return fechaNacimiento; }
 double Persona::getIngresosAnuales() const { return ingresosAnuales; }
 double Persona::getPatrimonio() const { return patrimonio; }
 double Persona::getDeudas() const { return deudas; }
@@ -39,10 +96,10 @@ bool Persona::getDeclaranteRenta() const { return declaranteRenta; }
 void Persona::mostrar() const {
     std::cout << "-------------------------------------\n";
     // Encabezado con ID y nombre completo
-    std::cout << "[" << id << "] Nombre: " << nombre << " " << apellido << "\n";
+    std::cout << "[" << id << "] Nombre: " << getNombre() << " " << getApellido() << "\n";
     // Datos personales
-    std::cout << "   - Ciudad de nacimiento: " << ciudadNacimiento << "\n";
-    std::cout << "   - Fecha de nacimiento: " << fechaNacimiento << "\n\n";
+    std::cout << "   - Ciudad de nacimiento: " << nombreCiudad(ciudadNacimiento) << "\n";
+    std::cout << "   - Fecha de nacimiento: " << formatearFecha(fechaNacimiento) << "\n\n";
 
     // Formato para valores monetarios (2 decimales)
     std::cout << std::fixed << std::setprecision(2);
@@ -58,95 +115,184 @@ void Persona::mostrar() const {
 // Versión compacta para mostrar en listados
 void Persona::mostrarResumen() const {
     // ID, nombre completo, ciudad e ingresos en una sola línea
-    std::cout << "[" << id << "] " << nombre << " " << apellido
-              << " | " << ciudadNacimiento
+    std::cout << "[" << id << "] " << getNombre() << " " << getApellido()
+              << " | " << nombreCiudad(ciudadNacimiento)
               << " | $" << std::fixed << std::setprecision(2) << ingresosAnuales;
 }
 
-// Clase auxiliar para manejar fechas
-class Fecha {
-    int anio, mes, dia;
-public:
-    Fecha(const std::string& fecha) {
-        sscanf(fecha.c_str(), "%d-%d-%d", &anio, &mes, &dia);
+void Persona::escribir(FormateadorBuffer& salida) const {
+    salida.texto("-------------------------------------\n");
+    const std::string_view nombre = getNombre(), apellido = getApellido();
+    salida.caracter('[').entero(id).texto("] Nombre: ").texto(nombre.data(), nombre.size()).caracter(' ')
+          .texto(apellido.data(), apellido.size()).caracter('\n');
+    salida.texto("   - Ciudad de nacimiento: ").texto(nombreCiudad(ciudadNacimiento)).caracter('\n');
+    salida.texto("   - Fecha de nacimiento: ").fecha(fechaNacimiento).texto("\n\n");
+    salida.texto("   - Ingresos anuales: $").decimal(ingresosAnuales).caracter('\n');
+    salida.texto("   - Patrimonio: $").decimal(patrimonio).caracter('\n');
+    salida.texto("   - Deudas: $").decimal(deudas).caracter('\n');
+    salida.texto("   - Declarante de renta: ").texto(declaranteRenta ? "Sí" : "No").caracter('\n');
+}
+
+void Persona::escribirResumen(FormateadorBuffer& salida) const {
+    const std::string_view nombre = getNombre(), apellido = getApellido();
+    salida.caracter('[').entero(id).texto("] ").texto(nombre.data(), nombre.size()).caracter(' ')
+          .texto(apellido.data(), apellido.size())
+          .texto(" | ").texto(nombreCiudad(ciudadNacimiento))
+          .texto(" | $").decimal(ingresosAnuales);
+}
+
+// Fecha de referencia para el cálculo de edades, fija para resultados deterministas
+static const std::int32_t FECHA_HOY = 20251228;
+
+// Lee un número de 'minimo' a 'maximo' dígitos; false si hay otra cosa
+static bool leerDigitos(std::string_view texto, std::size_t minimo, std::size_t maximo, int& valor) {
+    if (texto.size() < minimo || texto.size() > maximo) return false;
+    valor = 0;
+    for (char c : texto) {
+        if (c < '0' || c > '9') return false;
+        valor = valor * 10 + (c - '0');
     }
-    int getAnio() const { return anio; }
-    int getMes() const { return mes; }
-    int getDia() const { return dia; }
+    return true;
+}
 
-    // Obtiene la fecha actual como objeto Fecha
-    static Fecha hoy() {
-        int anioActual = 2025;
-        int mesActual = 12;
-        int diaActual = 28;
+static int diasDelMes(int anio, int mes) {
+    static const int DIAS[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    const bool bisiesto = (anio % 4 == 0 && anio % 100 != 0) || anio % 400 == 0;
+    return mes == 2 && bisiesto ? 29 : DIAS[mes - 1];
+}
 
-        char buffer[11];
-        snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", anioActual, mesActual, diaActual);
-        return Fecha(buffer);
+std::int32_t Persona::empaquetarFecha(std::string_view fecha) {
+    // DD/MM/AAAA o AAAA-MM-DD según el separador
+    const char separador = fecha.find('/') != std::string_view::npos ? '/' : '-';
+    const std::size_t primero = fecha.find(separador);
+    const std::size_t segundo = primero == std::string_view::npos ? primero : fecha.find(separador, primero + 1);
+    int anio = 0, mes = 0, dia = 0;
+    bool valida = segundo != std::string_view::npos;
+    if (valida) {
+        const std::string_view a = fecha.substr(0, primero);
+        const std::string_view b = fecha.substr(primero + 1, segundo - primero - 1);
+        const std::string_view c = fecha.substr(segundo + 1);
+        valida = separador == '/'
+            ? leerDigitos(a, 1, 2, dia) && leerDigitos(b, 1, 2, mes) && leerDigitos(c, 4, 4, anio)
+            : leerDigitos(a, 4, 4, anio) && leerDigitos(b, 1, 2, mes) && leerDigitos(c, 1, 2, dia);
     }
-};
+    valida = valida && anio >= 1 && mes >= 1 && mes <= 12 && dia >= 1 && dia <= diasDelMes(anio, mes);
+    if (!valida) {
+        throw std::invalid_argument("Fecha inválida: " + std::string(fecha));
+    }
+    return anio * 10000 + mes * 100 + dia;
+}
+
+std::string Persona::formatearFecha(std::int32_t fecha) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%02d/%02d/%04d",
+                  fecha % 100, (fecha / 100) % 100, fecha / 10000);
+    return buffer;
+}
 
 int Persona::calcularEdad() const {
-    Fecha nacimiento(fechaNacimiento);
-    Fecha actual = Fecha::hoy();
-    int edad = actual.getAnio() - nacimiento.getAnio();
+    // Con fechas AAAAMMDD la resta entera ya descuenta el año si aún no se
+    // cumplió el aniversario (el MMDD de hoy es menor que el de nacimiento)
+    return (FECHA_HOY - fechaNacimiento) / 10000;
+}
 
-    if (actual.getMes() < nacimiento.getMes() ||
-        (actual.getMes() == nacimiento.getMes() && actual.getDia() < nacimiento.getDia())) {
-        edad--;
+// Pasa cubetas indexadas por código de ciudad a un mapa por nombre.
+// El nombre se resuelve una vez por ciudad, no una vez por persona.
+// Con contenedores pmr, cubetas y mapa deben usar el mismo recurso (swap)
+template <typename Cubeta, typename Mapa>
+static void volcarCubetasEnMapa(std::vector<Cubeta> &cubetas, Mapa &grupos) {
+    for (std::size_t codigo = 0; codigo < cubetas.size(); ++codigo) {
+        Cubeta &cubeta = cubetas[codigo];
+        if (cubeta.empty()) continue;
+
+        const typename Mapa::key_type clave(nombreCiudad(static_cast<CodigoCiudad>(codigo)));
+        typename Mapa::mapped_type &destino = grupos[clave];
+        if (destino.empty()) {
+            destino.swap(cubeta);
+        } else {
+            destino.insert(destino.end(), cubeta.begin(), cubeta.end());
+        }
     }
+}
 
-    return edad;
+// Una cubeta vacía por ciudad, todas en 'recurso'. Se construyen una a una:
+// copiar un vector pmr lo llevaría al recurso por defecto
+static std::vector<std::pmr::vector<Persona>> cubetasPorCiudad(std::pmr::memory_resource* recurso) {
+    std::vector<std::pmr::vector<Persona>> cubetas;
+    cubetas.reserve(totalCiudades());
+    for (std::size_t c = 0; c < totalCiudades(); ++c) cubetas.emplace_back(recurso);
+    return cubetas;
 }
 
-std::map<std::string, std::vector<Persona>> Persona::agruparPorCiudadValor(const std::vector<Persona> personas){
-    std::map<std::string, std::vector<Persona>> grupos;
+Persona::GruposValor Persona::agruparPorCiudadValor(VistaPersonas personas,
+                                                   std::pmr::memory_resource* recurso){
+    GruposValor grupos(recurso);
+    std::vector<std::pmr::vector<Persona>> cubetas = cubetasPorCiudad(recurso);
 
     for(const auto &persona : personas){
-        std::string ciudadNacimiento = persona.getCiudadNacimiento();
-
-        grupos[persona.getCiudadNacimiento()].push_back(persona);
+        cubetas[persona.ciudadNacimiento].push_back(persona);
     }
 
+    volcarCubetasEnMapa(cubetas, grupos);
     return grupos;
 }
 
 void Persona::agruparPorCiudad(const std::vector<Persona> &personas,
                                std::map<std::string, std::vector<Persona>> &grupos) {
+    std::vector<std::vector<Persona>> cubetas(totalCiudades());
 
     for(const auto &persona : personas){
-        std::string ciudadNacimiento = persona.getCiudadNacimiento();
-
-        grupos[persona.getCiudadNacimiento()].push_back(persona);
+        cubetas[persona.ciudadNacimiento].push_back(persona);
     }
+
+    volcarCubetasEnMapa(cubetas, grupos);
 }
 
-void Persona::agruparPorDeclaracion(const std::vector<Persona> &personas,
-                                    std::map<std::string, std::vector<Persona>> &grupos) {
-    for(const auto &persona : personas){
-        std::string documento = persona.getId();
-        std::string ultimosDigitos = documento.substr( (documento.size() - 2) );
-        int digitosNumericos = std::stoi(ultimosDigitos);
+// ***************************** Calendario DIAN 2025 *************************************
+// El grupo depende solo de los dos últimos dígitos del documento (id % 100),
+// así que se resuelve con una tabla de 100 entradas: 0 = A, 1 = B, 2 = C.
 
-        if (digitosNumericos <= 39) grupos["A"].push_back(persona);
-        else if (digitosNumericos <= 79) grupos["B"].push_back(persona);
-        else if (digitosNumericos <= 99) grupos["C"].push_back(persona);
+struct TablaGruposDIAN {
+    unsigned char grupo[100];
+    TablaGruposDIAN() {
+        for (int dd = 0; dd < 100; ++dd) grupo[dd] = dd <= 39 ? 0 : (dd <= 79 ? 1 : 2);
     }
-}
+};
 
-std::map<std::string, std::vector<Persona>> Persona::agruparPorDeclaracionValor(const std::vector<Persona> personas) {
-    std::map<std::string, std::vector<Persona>> grupos;
+static const TablaGruposDIAN tablaGruposDIAN;
+static const char* const ETIQUETAS_DIAN[3] = {"Grupo A", "Grupo B", "Grupo C"};
+static const char* const LETRAS_DIAN[3] = {"A", "B", "C"};
 
-    for(const auto &persona : personas){
-        std::string documento = persona.getId();
-        std::string ultimosDigitos = documento.substr( (documento.size() - 2) );
-        int digitosNumericos = std::stoi(ultimosDigitos);
+int Persona::indiceGrupoDIAN(std::uint64_t id) {
+    return tablaGruposDIAN.grupo[ultimosDosDigitosCC(id)];
+}
+
+const char* Persona::etiquetaGrupoDIAN(int indice) {
+    return ETIQUETAS_DIAN[indice];
+}
 
-        if (digitosNumericos <= 39) grupos["A"].push_back(persona);
-        else if (digitosNumericos <= 79) grupos["B"].push_back(persona);
-        else if (digitosNumericos <= 99) grupos["C"].push_back(persona);
+// Grupo de cada letra, resuelto en el mapa una sola vez (crea la clave la
+// primera vez que aparece): por fila solo se indexa un arreglo, sin construir
+// la cadena de la clave ni buscar en el árbol
+template <typename Mapa>
+static void agruparPorLetra(VistaPersonas personas, Mapa &grupos) {
+    typename Mapa::mapped_type* destino[3] = {nullptr, nullptr, nullptr};
+    for (const Persona &persona : personas) {
+        const int g = Persona::indiceGrupoDIAN(persona.getId());
+        if (!destino[g]) destino[g] = &grupos[LETRAS_DIAN[g]];
+        destino[g]->push_back(persona);
     }
+}
+
+void Persona::agruparPorDeclaracion(const std::vector<Persona> &personas,
+                                    std::map<std::string, std::vector<Persona>> &grupos) {
+    agruparPorLetra(personas, grupos);
+}
 
+Persona::GruposValor Persona::agruparPorDeclaracionValor(VistaPersonas personas,
+                                                        std::pmr::memory_resource* recurso) {
+    GruposValor grupos(recurso);
+    agruparPorLetra(personas, grupos);
     return grupos;
 }
 
@@ -157,22 +303,23 @@ void Persona::personaMaxLongeva(const std::vector<Persona> &personas, Persona &l
         throw std::runtime_error("La lista está vacía");
     }
 
-    longeva = *std::max_element(personas.begin(), personas.end(),
+    // La más longeva es la de fecha de nacimiento (AAAAMMDD) más antigua
+    longeva = *std::min_element(personas.begin(), personas.end(),
                 [](const Persona &a, const Persona &b)
                 {
-                    return a.calcularEdad() < b.calcularEdad();
+                    return a.fechaNacimiento < b.fechaNacimiento;
                 });
 }
 
-Persona Persona::personaMaxLongevaValor(const std::vector<Persona> personas){
+Persona Persona::personaMaxLongevaValor(VistaPersonas personas){
     if(personas.empty()){
         throw std::runtime_error("La lista está vacía");
     }
 
-    return *std::max_element(personas.begin(), personas.end(),
+    return *std::min_element(personas.begin(), personas.end(),
                 [](const Persona &a, const Persona &b)
                 {
-                    return a.calcularEdad() < b.calcularEdad();
+                    return a.fechaNacimiento < b.fechaNacimiento;
                 });
 }
 
@@ -191,7 +338,7 @@ void Persona::personaMaxPatrimonio(const std::vector<Persona> &personas, Persona
                     });
 }
 
-Persona Persona::personaMaxPatrimonioValor(const std::vector<Persona> personas) {
+Persona Persona::personaMaxPatrimonioValor(VistaPersonas personas) {
     if(personas.empty()){
         throw std::runtime_error("La lista está vacía");
     }
@@ -205,38 +352,12 @@ Persona Persona::personaMaxPatrimonioValor(const std::vector<Persona> personas)
 
 
 // ***************************** (3) Declarantes de renta *************************************
-int Persona::ultimosDosDigitosCC(const std::string& id) {
-    int digito1= -1;
-    int digito2= -1;
-
-    for(int i = static_cast<int>(id.size()) -1; i >= 0; --i) {
-        unsigned char counter = static_cast<unsigned char>(id[i]);
-        if (std::isdigit(counter)) {
-            if (digito1 == -1) {
-                digito1 = counter - '0';
-            } else if (digito2 == -1) {
-                digito2 = counter - '0';
-                break;
-            }
-        }
-    }
-    if (digito1 == -1) return -1;
-    if (digito2 == -1) return digito1;
-    return digito2 * 10 + digito1;
-}
-
-
-std::string Persona::grupoDIANusandoDigitos(int dd){
-    if (dd < 0) return "Desconocido";
-    if (dd <= 39) return "Grupo A";
-    if (dd <= 79) return "Grupo B";
-    if (dd <= 99) return "Grupo C";
-    return "Desconocido";
+int Persona::ultimosDosDigitosCC(std::uint64_t id) {
+    return static_cast<int>(id % 100);
 }
 
 std::string Persona::grupoDIAN2025(const Persona& persona) {
-    int digitos = ultimosDosDigitosCC(persona.getId());
-    return grupoDIANusandoDigitos(digitos);
+    return ETIQUETAS_DIAN[indiceGrupoDIAN(persona.id)];
 }
 
 std::map<std::string, std::vector<const Persona*>>
@@ -245,116 +366,52 @@ Persona::agruparDeclarantesPorCalendarioPtr(const std::vector<Persona>& personas
     std::map<std::string, std::vector<const Persona*>> grupos;
 
 
-    grupos["Grupo A"];
-    grupos["Grupo B"];
-    grupos["Grupo C"];
-
-    if (contador) {
-        contador->clear();
-        (*contador)["Grupo A"] = 0;
-        (*contador)["Grupo B"] = 0;
-        (*contador)["Grupo C"] = 0;
-    }
+    // Claves creadas una vez; por fila solo se indexa por grupo
+    std::vector<const Persona*>* destino[3];
+    int conteo[3] = {0, 0, 0};
+    for (int g = 0; g < 3; ++g) destino[g] = &grupos[ETIQUETAS_DIAN[g]];
 
     for (const auto& persona : personas) {
         if (!persona.getDeclaranteRenta()) continue;
 
-        std::string grupo = grupoDIAN2025(persona);
-        if (grupo == "Grupo A" || grupo == "Grupo B" || grupo == "Grupo C") {
-            grupos[grupo].push_back(&persona);
-            if (contador) ++(*contador)[grupo];
-        }
+        const int g = indiceGrupoDIAN(persona.id);
+        destino[g]->push_back(&persona);
+        ++conteo[g];
+    }
+
+    if (contador) {
+        contador->clear();
+        for (int g = 0; g < 3; ++g) (*contador)[ETIQUETAS_DIAN[g]] = conteo[g];
     }
     return grupos;
 }
 
 Persona::CalendarioAgrupadito
-Persona::agruparDeclarantesPorCalendarioValor(std::vector<Persona> personas)
+Persona::agruparDeclarantesPorCalendarioValor(VistaPersonas personas,
+                                              std::pmr::memory_resource* recurso)
 {
-    CalendarioAgrupadito resultado;
-
-
-    resultado.grupos["Grupo A"] = std::vector<Persona>();
-    resultado.grupos["Grupo B"] = std::vector<Persona>();
-    resultado.grupos["Grupo C"] = std::vector<Persona>();
+    CalendarioAgrupadito resultado(recurso);
 
-    resultado.conteo["Grupo A"] = 0;
-    resultado.conteo["Grupo B"] = 0;
-    resultado.conteo["Grupo C"] = 0;
 
+    // Claves creadas una vez; por fila solo se indexa por grupo
+    std::pmr::vector<Persona>* grupos[3];
+    int* conteo[3];
+    for (int g = 0; g < 3; ++g) {
+        grupos[g] = &resultado.grupos[ETIQUETAS_DIAN[g]];
+        conteo[g] = &(resultado.conteo[ETIQUETAS_DIAN[g]] = 0);
+    }
 
-    for (auto personaActual : personas)
+    for (const Persona& personaActual : personas)
     {
         if (!personaActual.getDeclaranteRenta())
         {
             continue;
         }
 
-
-        std::string documento = personaActual.getId();
-
-        int ultimo = -1;
-        int penultimo = -1;
-
-        for (int i = static_cast<int>(documento.size()) - 1; i >= 0; --i)
-        {
-            char ch = documento[i];
-
-            if (ch >= '0' && ch <= '9')
-            {
-                if (ultimo == -1)
-                {
-                    ultimo = ch - '0';
-                }
-                else
-                {
-                    penultimo = ch - '0';
-                    break;
-                }
-            }
-        }
-
-        int dosDigitos;
-
-        if (ultimo == -1)
-        {
-            dosDigitos = -1;
-        }
-        else if (penultimo == -1)
-        {
-            dosDigitos = ultimo;
-        }
-        else
-        {
-            dosDigitos = penultimo * 10 + ultimo;
-        }
-
-        // asigación de grupitos
-        std::string grupo;
-
-        if (dosDigitos >= 0 && dosDigitos <= 39)
-        {
-            grupo = "Grupo A";
-        }
-        else if (dosDigitos >= 40 && dosDigitos <= 79)
-        {
-            grupo = "Grupo B";
-        }
-        else if (dosDigitos >= 80 && dosDigitos <= 99)
-        {
-            grupo = "Grupo C";
-        }
-        else
-        {
-            grupo = "Desconocido";
-        }
-
-        // Solo guardamos A/B/C
-        if (grupo == "Grupo A" || grupo == "Grupo B" || grupo == "Grupo C")
-        {
-            resultado.grupos[grupo].push_back(personaActual);
-            resultado.conteo[grupo] = resultado.conteo[grupo] + 1;
-        }
+        // Todo documento numérico cae en A, B o C
+        const int g = indiceGrupoDIAN(personaActual.id);
+        grupos[g]->push_back(personaActual);
+        ++*conteo[g];
     }
 
     return resultado;
@@ -362,8 +419,7 @@ Persona::agruparDeclarantesPorCalendarioValor(std::vector<Persona> personas)
 
 bool Persona::validarAsignacionCalendario(const Persona& persona, const std::string& grupoEsperado) {
     if (!persona.getDeclaranteRenta()) return false;
-    std::string grupo = grupoDIAN2025(persona);
-    return grupo == grupoEsperado;
+    return grupoEsperado == ETIQUETAS_DIAN[indiceGrupoDIAN(persona.id)];
 }
 
 //===============================(4) Menor Patrimonio ==================================
@@ -379,7 +435,7 @@ void Persona::personaMinPatrimonio(const std::vector<Persona> &personas, Persona
                     });
 }
 
-Persona Persona::personaMinPatrimonioValor(const std::vector<Persona> personas){
+Persona Persona::personaMinPatrimonioValor(VistaPersonas personas){
     if(personas.empty()){
         throw std::runtime_error("La lista está vacía");
     }
@@ -404,7 +460,7 @@ void Persona::personaMaxDeuda(const std::vector<Persona> &personas, Persona &max
             });
 }
 
-Persona Persona::personaMaxDeudaValor(const std::vector<Persona> personas) {
+Persona Persona::personaMaxDeudaValor(VistaPersonas personas) {
     if(personas.empty()){
         throw std::runtime_error("La lista está vacía");
     }
@@ -418,17 +474,23 @@ Persona Persona::personaMaxDeudaValor(const std::vector<Persona> personas) {
 
 //===============================(6) Declarantes por ciudad ==================================
 
-std::map<std::string, std::vector<Persona>> Persona::declarantePorCiudadValor(const std::vector<Persona> personas) {
-    std::map<std::string, std::vector<Persona>> resultado = Persona::agruparPorCiudadValor(personas);
-
-    for (auto& par : resultado) {
-        std::vector<Persona>& grupo = par.second;
-        grupo.erase(std::remove_if(grupo.begin(), grupo.end(),
-                    [](const Persona& p) {
-                        return !p.getDeclaranteRenta();
-                    }), grupo.end());
+Persona::GruposValor Persona::declarantePorCiudadValor(VistaPersonas personas,
+                                                      std::pmr::memory_resource* recurso) {
+    // Solo se copian los declarantes; toda ciudad presente aparece aunque quede vacía
+    std::vector<std::pmr::vector<Persona>> cubetas = cubetasPorCiudad(recurso);
+    std::vector<unsigned char> presentes(cubetas.size(), 0);
+    for (const Persona& persona : personas) {
+        presentes[persona.ciudadNacimiento] = 1;
+        if (persona.declaranteRenta) cubetas[persona.ciudadNacimiento].push_back(persona);
     }
 
+    GruposValor resultado(recurso);
+    for (std::size_t codigo = 0; codigo < cubetas.size(); ++codigo) {
+        if (presentes[codigo]) {
+            const std::pmr::string clave(nombreCiudad(static_cast<CodigoCiudad>(codigo)));
+            resultado[clave].swap(cubetas[codigo]);
+        }
+    }
     return resultado;
 }
 
@@ -446,3 +508,225 @@ void Persona::declarantePorCiudad(const std::vector<Persona> &personas,
     }
 
 }
+
+
+//===============================(7) Consultas sobre almacén columnar ==================================
+// Cada recorrido lee una sola columna contigua. En empates se conserva la
+// primera fila, igual que std::max_element / std::min_element.
+
+void Persona::personaMaxLongeva(const PersonaStore &store, std::size_t &indice) {
+    if(store.empty()){
+        throw std::runtime_error("La lista está vacía");
+    }
+
+    // La persona más longeva es la de fecha de nacimiento (AAAAMMDD) más antigua
+    const std::int32_t* fechas = store.getFechaNacimiento();
+    std::size_t mejor = 0;
+    for (std::size_t i = 1, n = store.size(); i < n; ++i) {
+        if (fechas[i] < fechas[mejor]) mejor = i;
+    }
+    indice = mejor;
+}
+
+void Persona::personaMaxPatrimonio(const PersonaStore &store, std::size_t &indice) {
+    if(store.empty()){
+        throw std::runtime_error("La lista está vacía");
+    }
+
+    const double* patrimonio = store.getPatrimonio();
+    std::size_t mejor = 0;
+    for (std::size_t i = 1, n = store.size(); i < n; ++i) {
+        if (patrimonio[mejor] < patrimonio[i]) mejor = i;
+    }
+    indice = mejor;
+}
+
+void Persona::personaMinPatrimonio(const PersonaStore &store, std::size_t &indice) {
+    if(store.empty()){
+        throw std::runtime_error("La lista está vacía");
+    }
+
+    const double* patrimonio = store.getPatrimonio();
+    std::size_t mejor = 0;
+    for (std::size_t i = 1, n = store.size(); i < n; ++i) {
+        if (patrimonio[i] < patrimonio[mejor]) mejor = i;
+    }
+    indice = mejor;
+}
+
+void Persona::personaMaxDeuda(const PersonaStore &store, std::size_t &indice) {
+    if(store.empty()){
+        throw std::runtime_error("La lista está vacía");
+    }
+
+    const double* deudas = store.getDeudas();
+    std::size_t mejor = 0;
+    for (std::size_t i = 1, n = store.size(); i < n; ++i) {
+        if (deudas[mejor] < deudas[i]) mejor = i;
+    }
+    indice = mejor;
+}
+
+// Variantes vectoriales: los núcleos de simd.h recorren la columna completa
+
+void Persona::personaMaxPatrimonioSIMD(const PersonaStore &store, std::size_t &indice) {
+    if(store.empty()){
+        throw std::runtime_error("La lista está vacía");
+    }
+    indice = argMaxDouble(store.getPatrimonio(), store.size());
+}
+
+void Persona::personaMinPatrimonioSIMD(const PersonaStore &store, std::size_t &indice) {
+    if(store.empty()){
+        throw std::runtime_error("La lista está vacía");
+    }
+    indice = argMinDouble(store.getPatrimonio(), store.size());
+}
+
+void Persona::personaMaxDeudaSIMD(const PersonaStore &store, std::size_t &indice) {
+    if(store.empty()){
+        throw std::runtime_error("La lista está vacía");
+    }
+    indice = argMaxDouble(store.getDeudas(), store.size());
+}
+
+void Persona::personaMaxIngresosSIMD(const PersonaStore &store, std::size_t &indice) {
+    if(store.empty()){
+        throw std::runtime_error("La lista está vacía");
+    }
+    indice = argMaxDouble(store.getIngresosAnuales(), store.size());
+}
+
+void Persona::personaMinIngresosSIMD(const PersonaStore &store, std::size_t &indice) {
+    if(store.empty()){
+        throw std::runtime_error("La lista está vacía");
+    }
+    indice = argMinDouble(store.getIngresosAnuales(), store.size());
+}
+
+//===============================(8) Agrupación por índices ==================================
+// Los grupos contienen posiciones en el vector original; la única memoria
+// adicional es un uint32_t por persona agrupada.
+
+// Verifica que las posiciones del vector quepan en un índice de 32 bits
+static void validarTamanoIndices(const std::vector<Persona> &personas) {
+    if (personas.size() > UINT32_MAX) {
+        throw std::length_error("Demasiadas personas para índices de 32 bits");
+    }
+}
+
+void Persona::agruparPorCodigoCiudad(const std::vector<Persona> &personas,
+                                     std::vector<std::vector<std::uint32_t>> &grupos) {
+    validarTamanoIndices(personas);
+
+    // Primera pasada: cuántas personas hay por código, para reservar exacto
+    std::vector<std::uint32_t> conteo(totalCiudades(), 0);
+    for (const auto &persona : personas) ++conteo[persona.ciudadNacimiento];
+
+    grupos.assign(conteo.size(), std::vector<std::uint32_t>());
+    for (std::size_t codigo = 0; codigo < conteo.size(); ++codigo) {
+        grupos[codigo].reserve(conteo[codigo]);
+    }
+
+    // Segunda pasada: cada índice va directo a la cubeta de su código
+    const std::uint32_t n = static_cast<std::uint32_t>(personas.size());
+    for (std::uint32_t i = 0; i < n; ++i) {
+        grupos[personas[i].ciudadNacimiento].push_back(i);
+    }
+}
+
+void Persona::agruparPorCiudad(const std::vector<Persona> &personas,
+                               std::map<std::string, std::vector<std::uint32_t>> &grupos) {
+    std::vector<std::vector<std::uint32_t>> cubetas;
+    agruparPorCodigoCiudad(personas, cubetas);
+    volcarCubetasEnMapa(cubetas, grupos);
+}
+
+void Persona::agruparPorDeclaracion(const std::vector<Persona> &personas,
+                                    std::map<std::string, std::vector<std::uint32_t>> &grupos) {
+    validarTamanoIndices(personas);
+
+    // Referencias directas a los tres grupos para no buscar en el mapa por fila
+    std::vector<std::uint32_t>* destino[3] = {&grupos["A"], &grupos["B"], &grupos["C"]};
+
+    const std::uint32_t n = static_cast<std::uint32_t>(personas.size());
+    for (std::uint32_t i = 0; i < n; ++i) {
+        destino[indiceGrupoDIAN(personas[i].id)]->push_back(i);
+    }
+}
+
+void Persona::declarantePorCiudad(const std::vector<Persona> &personas,
+                                  std::map<std::string, std::vector<std::uint32_t>> &grupos) {
+    validarTamanoIndices(personas);
+
+    // Se filtra antes de insertar: los no declarantes nunca ocupan memoria
+    std::vector<std::vector<std::uint32_t>> cubetas(totalCiudades());
+    std::vector<bool> ciudadPresente(cubetas.size(), false);
+
+    const std::uint32_t n = static_cast<std::uint32_t>(personas.size());
+    for (std::uint32_t i = 0; i < n; ++i) {
+        const Persona &persona = personas[i];
+        ciudadPresente[persona.ciudadNacimiento] = true;
+        if (persona.declaranteRenta) cubetas[persona.ciudadNacimiento].push_back(i);
+    }
+
+    // Igual que la versión por copia, toda ciudad presente aparece aunque no tenga declarantes
+    for (std::size_t codigo = 0; codigo < cubetas.size(); ++codigo) {
+        if (ciudadPresente[codigo]) grupos[nombreCiudad(static_cast<CodigoCiudad>(codigo))];
+    }
+    volcarCubetasEnMapa(cubetas, grupos);
+}
+
+// Recorre un grupo de índices y devuelve la posición del mejor elemento según 'menor'.
+// En empates conserva el primero, igual que std::max_element / std::min_element.
+template <typename Menor>
+static std::uint32_t mejorIndice(const std::vector<Persona> &personas,
+                                 const std::vector<std::uint32_t> &indices, Menor menor) {
+    if (indices.empty()) {
+        throw std::runtime_error("La lista está vacía");
+    }
+
+    std::uint32_t mejor = indices[0];
+    for (std::size_t k = 1; k < indices.size(); ++k) {
+        if (menor(personas[mejor], personas[indices[k]])) mejor = indices[k];
+    }
+    return mejor;
+}
+
+void Persona::personaMaxLongeva(const std::vector<Persona> &personas,
+                                const std::vector<std::uint32_t> &indices, Persona &longeva) {
+    // Mínimo de la fecha empaquetada: el "mejor" es el nacido antes
+    longeva = personas[mejorIndice(personas, indices,
+                [](const Persona &a, const Persona &b)
+                {
+                    return b.fechaNacimiento < a.fechaNacimiento;
+                })];
+}
+
+void Persona::personaMaxPatrimonio(const std::vector<Persona> &personas,
+                                   const std::vector<std::uint32_t> &indices, Persona &maxPatrimonio) {
+    maxPatrimonio = personas[mejorIndice(personas, indices,
+                    [](const Persona &a, const Persona &b)
+                    {
+                        return a.getPatrimonio() < b.getPatrimonio();
+                    })];
+}
+
+void Persona::personaMinPatrimonio(const std::vector<Persona> &personas,
+                                   const std::vector<std::uint32_t> &indices, Persona &minPatrimonio) {
+    // Mínimo: el "mejor" es el que no es mayor que el actual
+    minPatrimonio = personas[mejorIndice(personas, indices,
+                    [](const Persona &a, const Persona &b)
+                    {
+                        return b.getPatrimonio() < a.getPatrimonio();
+                    })];
+}
+
+void Persona::personaMaxDeuda(const std::vector<Persona> &personas,
+                              const std::vector<std::uint32_t> &indices, Persona &maxDeuda) {
+    maxDeuda = personas[mejorIndice(personas, indices,
+            [](const Persona &a, const Persona &b)
+            {
+                return a.getDeudas() < b.getDeudas();
+            })];
+}
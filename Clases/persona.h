@@ -1,48 +1,88 @@
 #ifndef PERSONA_H
 #define PERSONA_H
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "ciudades.h"
+
+class PersonaStore; // Almacén columnar (persona_store.h)
+class FormateadorBuffer; // Salida masiva (formateador.h)
+class VistaPersonas; // Vista sin copia de un arreglo de personas (al final del archivo)
+
 // Clase que representa una persona con datos personales y fiscales
 class Persona {
 private:
     // Datos básicos de identificación
-    std::string nombre;           // Nombre de pila
-    std::string apellido;         // Apellidos
-    std::string id;               // Identificador único
-    std::string ciudadNacimiento; // Ciudad de nacimiento en Colombia
-    std::string fechaNacimiento;  // Fecha en formato DD/MM/AAAA
+    // Nombre y apellido van juntos en un solo texto (una reserva por persona);
+    // 'largoNombre' marca el corte. El texto vive en el recurso std::pmr con el
+    // que se construyó la persona: una arena del dataset o de la consulta
+    // (ver arena.h), o el recurso por defecto
+    std::pmr::string textos;      // Nombre de pila seguido de los apellidos
+    std::uint64_t id;             // Identificador único (documento numérico)
+    CodigoCiudad ciudadNacimiento; // Código de la ciudad de nacimiento (ver ciudades.h)
+    std::uint16_t largoNombre;    // Bytes del nombre al inicio de 'textos'
+    std::int32_t fechaNacimiento; // Fecha empaquetada AAAAMMDD (se analiza una sola vez)
 
     // Datos fiscales y económicos
     double ingresosAnuales;       // Ingresos anuales en pesos colombianos
     double patrimonio;            // Valor total de bienes y activos
     double deudas;                // Deudas pendientes
     bool declaranteRenta;         // Si está obligado a declarar renta
-    static int ultimosDosDigitosCC(const std::string& id);
-    static std::string grupoDIANusandoDigitos(int dd);
+    static int ultimosDosDigitosCC(std::uint64_t id);
+    void asignarTextos(std::string_view nom, std::string_view ape);
 public:
+    // Persona usa asignadores: un std::pmr::vector<Persona> construye sus
+    // copias en su propio recurso (p. ej. los grupos *Valor en la arena de la
+    // consulta). En un std::vector normal se comporta como antes
+    typedef std::pmr::polymorphic_allocator<char> allocator_type;
+
+    // Resultado de los agrupadores *Valor: el mapa, sus claves y los vectores de
+    // copias se reservan en el recurso que reciba la consulta (ver arena.h)
+    typedef std::pmr::map<std::pmr::string, std::pmr::vector<Persona>> GruposValor;
 
     class CalendarioAgrupadito {
         public:
-            std::map<std::string, std::vector<Persona>> grupos;
-            std::map<std::string, int> conteo;
+            explicit CalendarioAgrupadito(std::pmr::memory_resource* recurso = std::pmr::get_default_resource())
+                : grupos(recurso), conteo(recurso) {}
+            GruposValor grupos;
+            std::pmr::map<std::pmr::string, int> conteo;
         };
     
     Persona(); // Constructor por defecto
     // Constructor: Inicializa todos los campos de la persona
-    Persona(std::string nom, std::string ape, std::string id,
+    Persona(std::string_view nom, std::string_view ape, std::string id,
             std::string ciudad, std::string fecha, double ingresos,
             double patri, double deud, bool declara);
+    // Constructor con id, ciudad y fecha ya codificados (sin análisis de texto).
+    // 'recurso' = memoria del nombre y el apellido
+    Persona(std::string_view nom, std::string_view ape, std::uint64_t id,
+            CodigoCiudad ciudad, std::int32_t fecha, double ingresos,
+            double patri, double deud, bool declara,
+            std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
+    // Las copias usan el recurso por defecto salvo que se indique otro
+    Persona(const Persona& otra) = default;
+    Persona(Persona&& otra) = default;
+    Persona(const Persona& otra, const allocator_type& asignador);
+    Persona(Persona&& otra, const allocator_type& asignador);
+    Persona& operator=(const Persona& otra) = default;
+    Persona& operator=(Persona&& otra) = default;
 
     // --- Métodos de acceso (getters) ---
     // Permiten obtener valores de campos privados sin exponer implementación
-    std::string getNombre() const;
-    std::string getApellido() const;
-    std::string getId() const;
-    std::string getCiudadNacimiento() const;
-    std::string getFechaNacimiento() const;
+    // Los textos se devuelven como vista: leerlos no asigna memoria
+    std::string_view getNombre() const;
+    std::string_view getApellido() const;
+    std::uint64_t getId() const;
+    const std::string& getCiudadNacimiento() const; // Nombre en el diccionario (referencia estable)
+    CodigoCiudad getCodigoCiudad() const;
+    std::string getFechaNacimiento() const; // Formato DD/MM/AAAA
+    std::int32_t getFechaEmpaquetada() const; // AAAAMMDD
     double getIngresosAnuales() const;
     double getPatrimonio() const;
     double getDeudas() const;
@@ -51,18 +91,46 @@ public:
     // --- Métodos de visualización ---
     void mostrar() const;         // Muestra todos los detalles completos
     void mostrarResumen() const;  // Muestra versión compacta para listados
+    // Mismo texto que mostrar()/mostrarResumen(), escrito en un búfer de salida masiva
+    void escribir(FormateadorBuffer& salida) const;
+    void escribirResumen(FormateadorBuffer& salida) const;
     int calcularEdad() const; // Calcula la edad a partir de la fecha de nacimiento
 
-    /* Funciones agrupadoras */
+    /* Conversión de fechas: "DD/MM/AAAA" o "AAAA-MM-DD" <-> entero AAAAMMDD.
+       empaquetarFecha exige año de 4 dígitos, mes 1-12 y un día que exista en
+       ese mes; si no, lanza std::invalid_argument */
+    static std::int32_t empaquetarFecha(std::string_view fecha);
+    static std::string formatearFecha(std::int32_t fecha);
+    // Documento textual -> número (lanza std::invalid_argument si no son solo dígitos)
+    static std::uint64_t convertirID(const std::string& texto);
+
+    /* Funciones agrupadoras. Las *Valor reservan su resultado en 'recurso':
+       con una arena de consulta, liberarlo es liberar los bloques de la arena */
     static void agruparPorCiudad(const std::vector<Persona> &personas, std::map<std::string, std::vector<Persona>> &grupos);
-    static std::map<std::string, std::vector<Persona>> agruparPorCiudadValor(const std::vector<Persona> personas);
+    static GruposValor agruparPorCiudadValor(VistaPersonas personas,
+                                             std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
     static void agruparPorDeclaracion(const std::vector<Persona> &personas, std::map<std::string, std::vector<Persona>> &grupos);
-    static std::map<std::string, std::vector<Persona>> agruparPorDeclaracionValor(const std::vector<Persona> personas);
+    static GruposValor agruparPorDeclaracionValor(VistaPersonas personas,
+                                                  std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
     static void declarantePorCiudad(const std::vector<Persona> &personas, std::map<std::string, std::vector<Persona>> &grupos);
-    static std::map<std::string, std::vector<Persona>> declarantePorCiudadValor(const std::vector<Persona> personas);
+    static GruposValor declarantePorCiudadValor(VistaPersonas personas,
+                                                std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
+
+    /* Agrupadores por índice: cada grupo guarda posiciones (uint32_t) en 'personas'
+       en lugar de copias, por lo que agrupar no duplica el dataset */
+    static void agruparPorCiudad(const std::vector<Persona> &personas, std::map<std::string, std::vector<std::uint32_t>> &grupos);
+    static void agruparPorDeclaracion(const std::vector<Persona> &personas, std::map<std::string, std::vector<std::uint32_t>> &grupos);
+    static void declarantePorCiudad(const std::vector<Persona> &personas, std::map<std::string, std::vector<std::uint32_t>> &grupos);
+
+    /* Agrupador por código de ciudad: grupos[codigo] contiene los índices de esa ciudad.
+       Es un conteo más un llenado, sin comparar cadenas */
+    static void agruparPorCodigoCiudad(const std::vector<Persona> &personas, std::vector<std::vector<std::uint32_t>> &grupos);
 
 
     static std::string grupoDIAN2025(const Persona& persona);
+    // Grupo DIAN por tabla sobre id % 100: 0 = "Grupo A", 1 = "Grupo B", 2 = "Grupo C"
+    static int indiceGrupoDIAN(std::uint64_t id);
+    static const char* etiquetaGrupoDIAN(int indice);
     static std::map<std::string, std::vector<const Persona*>>
     agruparDeclarantesPorCalendarioPtr(const std::vector<Persona>& personas,
                                     std::map<std::string, int>* contador = nullptr);
@@ -70,18 +138,64 @@ public:
     contarDeclarantesPorCalendario(const std::vector<Persona>& personas);
     static bool validarAsignacionCalendario(const Persona& p, const std::string& grupoEsperado);
     static CalendarioAgrupadito
-    agruparDeclarantesPorCalendarioValor(std::vector<Persona> personas);
+    agruparDeclarantesPorCalendarioValor(VistaPersonas personas,
+                                         std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
     
     /* Funciones de busqueda */
     static void personaMaxLongeva(const std::vector<Persona> &personas, Persona &longeva);
-    static Persona personaMaxLongevaValor(const std::vector<Persona> personas);
+    static Persona personaMaxLongevaValor(VistaPersonas personas);
     static void personaMaxPatrimonio(const std::vector<Persona> &personas, Persona &maxPatrimonio);
-    static Persona personaMaxPatrimonioValor(const std::vector<Persona> personas);
+    static Persona personaMaxPatrimonioValor(VistaPersonas personas);
     static void personaMinPatrimonio(const std::vector<Persona>& personas, Persona &minPatrimonio);
-    static Persona personaMinPatrimonioValor(const std::vector<Persona> personas);
+    static Persona personaMinPatrimonioValor(VistaPersonas personas);
     static void personaMaxDeuda(const std::vector<Persona> &personas, Persona &maxDeuda);
-    static Persona personaMaxDeudaValor(const std::vector<Persona> personas);
+    static Persona personaMaxDeudaValor(VistaPersonas personas);
+
+    /* Funciones de busqueda sobre un grupo de índices en 'personas' */
+    static void personaMaxLongeva(const std::vector<Persona> &personas, const std::vector<std::uint32_t> &indices, Persona &longeva);
+    static void personaMaxPatrimonio(const std::vector<Persona> &personas, const std::vector<std::uint32_t> &indices, Persona &maxPatrimonio);
+    static void personaMinPatrimonio(const std::vector<Persona> &personas, const std::vector<std::uint32_t> &indices, Persona &minPatrimonio);
+    static void personaMaxDeuda(const std::vector<Persona> &personas, const std::vector<std::uint32_t> &indices, Persona &maxDeuda);
+
+    /* Funciones de busqueda sobre el almacén columnar (devuelven el índice de fila) */
+    static void personaMaxLongeva(const PersonaStore &store, std::size_t &indice);
+    static void personaMaxPatrimonio(const PersonaStore &store, std::size_t &indice);
+    static void personaMinPatrimonio(const PersonaStore &store, std::size_t &indice);
+    static void personaMaxDeuda(const PersonaStore &store, std::size_t &indice);
 
+    /* Variantes vectoriales (AVX2/SSE4.1 según la CPU, ver simd.h) sobre las
+       columnas monetarias del almacén; mismo resultado que las escalares */
+    static void personaMaxPatrimonioSIMD(const PersonaStore &store, std::size_t &indice);
+    static void personaMinPatrimonioSIMD(const PersonaStore &store, std::size_t &indice);
+    static void personaMaxDeudaSIMD(const PersonaStore &store, std::size_t &indice);
+    static void personaMaxIngresosSIMD(const PersonaStore &store, std::size_t &indice);
+    static void personaMinIngresosSIMD(const PersonaStore &store, std::size_t &indice);
+
+};
+
+// Vista de solo lectura sobre personas contiguas (puntero + longitud), al estilo
+// de std::span. Las funciones *Valor la reciben por valor: copiarla cuesta dos
+// palabras, no el dataset, y sus resultados siguen siendo copias independientes.
+// La vista no es dueña de los datos: el vector debe vivir mientras se use.
+class VistaPersonas {
+public:
+    VistaPersonas() : inicio(nullptr), total(0) {}
+    VistaPersonas(const Persona* datos, std::size_t n) : inicio(datos), total(n) {}
+    VistaPersonas(const std::vector<Persona>& personas) // Conversión implícita
+        : inicio(personas.data()), total(personas.size()) {}
+    VistaPersonas(const std::pmr::vector<Persona>& personas) // Grupos de GruposValor
+        : inicio(personas.data()), total(personas.size()) {}
+
+    const Persona* begin() const { return inicio; }
+    const Persona* end() const { return inicio + total; }
+    const Persona* data() const { return inicio; }
+    std::size_t size() const { return total; }
+    bool empty() const { return total == 0; }
+    const Persona& operator[](std::size_t i) const { return inicio[i]; }
+
+private:
+    const Persona* inicio;
+    std::size_t total;
 };
 
 #endif // PERSONA_H
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "persona_store.h"
+#include <cmath>
+#include <stdexcept>
+
+Centavos aCentavos(double pesos) {
+    const double centavos = std::round(pesos * 100.0);
+    // 2^63 es exacto en double; la negación también descarta NaN
+    if (!(centavos >= -9223372036854775808.0 && centavos < 9223372036854775808.0)) {
+        throw std::out_of_range("Cantidad fuera del rango de centavos de 64 bits");
+    }
+    return static_cast<Centavos>(centavos);
+}
+
+PersonaStore::PersonaStore() {
+    apuntarAPropias();
+}
+
+PersonaStore::PersonaStore(const std::vector<Persona>& personas) {
+    cargar(personas);
+}
+
+void PersonaStore::apuntarAPropias() {
+    filas = patrimonio.size();
+    colId = id.data();
+    colIngresos = ingresosAnuales.data();
+    colPatrimonio = patrimonio.data();
+    colDeudas = deudas.data();
+    colDeclarante = declaranteRenta.data();
+    colCiudad = ciudad.data();
+    colFecha = fechaNacimiento.data();
+    externo = false;
+    descartarCentavos();
+}
+
+void PersonaStore::descartarCentavos() {
+    std::vector<Centavos>().swap(ingresosCentavos);
+    std::vector<Centavos>().swap(patrimonioCentavos);
+    std::vector<Centavos>().swap(deudasCentavos);
+    colIngresosCentavos = nullptr;
+    colPatrimonioCentavos = nullptr;
+    colDeudasCentavos = nullptr;
+    conCentavos = false;
+}
+
+void PersonaStore::referenciar(std::size_t n, const std::uint64_t* idExt, const double* ingresosExt,
+                               const double* patrimonioExt, const double* deudasExt,
+                               const std::uint8_t* declaranteExt, const CodigoCiudad* ciudadExt,
+                               const std::int32_t* fechaExt) {
+    // Libera las columnas propias: ya no se consultan
+    std::vector<std::uint64_t>().swap(id);
+    std::vector<double>().swap(ingresosAnuales);
+    std::vector<double>().swap(patrimonio);
+    std::vector<double>().swap(deudas);
+    descartarCentavos();
+    std::vector<std::uint8_t>().swap(declaranteRenta);
+    std::vector<CodigoCiudad>().swap(ciudad);
+    std::vector<std::int32_t>().swap(fechaNacimiento);
+
+    filas = n;
+    colId = idExt;
+    colIngresos = ingresosExt;
+    colPatrimonio = patrimonioExt;
+    colDeudas = deudasExt;
+    colDeclarante = declaranteExt;
+    colCiudad = ciudadExt;
+    colFecha = fechaExt;
+    externo = true;
+}
+
+void PersonaStore::cargar(const std::vector<Persona>& personas) {
+    const std::size_t n = personas.size();
+
+    id.assign(n, 0);
+    ingresosAnuales.assign(n, 0.0);
+    patrimonio.assign(n, 0.0);
+    deudas.assign(n, 0.0);
+    declaranteRenta.assign(n, 0);
+    ciudad.assign(n, 0);
+    fechaNacimiento.assign(n, 0);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const Persona& p = personas[i];
+        id[i] = p.getId();
+        ingresosAnuales[i] = p.getIngresosAnuales();
+        patrimonio[i] = p.getPatrimonio();
+        deudas[i] = p.getDeudas();
+        declaranteRenta[i] = p.getDeclaranteRenta() ? 1 : 0;
+        fechaNacimiento[i] = p.getFechaEmpaquetada();
+        ciudad[i] = p.getCodigoCiudad();
+    }
+    apuntarAPropias();
+}
+
+void PersonaStore::materializarCentavos() {
+    // Se convierte en vectores locales: si una cantidad no cabe, el almacén
+    // queda como estaba
+    std::vector<Centavos> ingresosC(filas), patrimonioC(filas), deudasC(filas);
+    for (std::size_t i = 0; i < filas; ++i) {
+        ingresosC[i] = aCentavos(colIngresos[i]);
+        patrimonioC[i] = aCentavos(colPatrimonio[i]);
+        deudasC[i] = aCentavos(colDeudas[i]);
+    }
+    ingresosCentavos.swap(ingresosC);
+    patrimonioCentavos.swap(patrimonioC);
+    deudasCentavos.swap(deudasC);
+    colIngresosCentavos = ingresosCentavos.data();
+    colPatrimonioCentavos = patrimonioCentavos.data();
+    colDeudasCentavos = deudasCentavos.data();
+    conCentavos = true;
+}
+
+bool PersonaStore::tieneCentavos() const { return conCentavos; }
+
+std::size_t PersonaStore::size() const { return filas; }
+bool PersonaStore::empty() const { return filas == 0; }
+bool PersonaStore::esExterno() const { return externo; }
+
+const std::uint64_t* PersonaStore::getId() const { return colId; }
+const double* PersonaStore::getIngresosAnuales() const { return colIngresos; }
+const double* PersonaStore::getPatrimonio() const { return colPatrimonio; }
+const double* PersonaStore::getDeudas() const { return colDeudas; }
+const Centavos* PersonaStore::getIngresosCentavos() const { return colIngresosCentavos; }
+const Centavos* PersonaStore::getPatrimonioCentavos() const { return colPatrimonioCentavos; }
+const Centavos* PersonaStore::getDeudasCentavos() const { return colDeudasCentavos; }
+const std::uint8_t* PersonaStore::getDeclaranteRenta() const { return colDeclarante; }
+const CodigoCiudad* PersonaStore::getCiudad() const { return colCiudad; }
+const std::int32_t* PersonaStore::getFechaNacimiento() const { return colFecha; }
@@ -0,0 +1,100 @@
+#ifndef PERSONA_STORE_H
+#define PERSONA_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "persona.h"
+
+// Cantidad de dinero en centavos enteros
+typedef std::int64_t Centavos;
+
+// Pesos a centavos, redondeando al centavo más cercano. Lanza
+// std::out_of_range si la cantidad no cabe en 64 bits (o no es un número).
+Centavos aCentavos(double pesos);
+
+// Almacén columnar (struct-of-arrays) de personas para consultas analíticas.
+// Cada campo consultado vive en su propio arreglo contiguo, de modo que un
+// recorrido de máximo/mínimo lee solo la columna que necesita (~8 bytes por
+// fila) en lugar de objetos Persona completos con cinco std::string.
+// La fila i corresponde a la posición i del vector de origen.
+// También puede apuntar a columnas externas (p. ej. un snapshot mapeado con
+// mmap) sin copiarlas; las consultas usan los mismos punteros en ambos casos.
+// Opcionalmente el dinero se guarda también en centavos enteros (ver
+// materializarCentavos): los extremos se buscan en las columnas double
+// (mismos desempates que Persona) y las sumas exactas en las enteras.
+class PersonaStore {
+private:
+    std::vector<std::uint64_t> id;            // Documento de identidad
+    std::vector<double> ingresosAnuales;      // Ingresos anuales en pesos
+    std::vector<double> patrimonio;           // Valor total de bienes y activos
+    std::vector<double> deudas;               // Deudas pendientes
+    std::vector<Centavos> ingresosCentavos;   // Las tres cantidades anteriores
+    std::vector<Centavos> patrimonioCentavos; // en centavos; vacías hasta
+    std::vector<Centavos> deudasCentavos;     // materializarCentavos()
+    std::vector<std::uint8_t> declaranteRenta; // 1 si declara renta, 0 si no
+    std::vector<CodigoCiudad> ciudad;         // Código de ciudad (ver ciudades.h)
+    std::vector<std::int32_t> fechaNacimiento; // Fecha empaquetada AAAAMMDD
+
+    // Columnas vigentes: los vectores propios o memoria externa
+    std::size_t filas;
+    const std::uint64_t* colId;
+    const double* colIngresos;
+    const double* colPatrimonio;
+    const double* colDeudas;
+    const Centavos* colIngresosCentavos;
+    const Centavos* colPatrimonioCentavos;
+    const Centavos* colDeudasCentavos;
+    const std::uint8_t* colDeclarante;
+    const CodigoCiudad* colCiudad;
+    const std::int32_t* colFecha;
+    bool externo;
+    bool conCentavos; // Columnas en centavos materializadas
+
+    void apuntarAPropias();
+    void descartarCentavos();
+
+    PersonaStore(const PersonaStore&);            // No copiable: los punteros
+    PersonaStore& operator=(const PersonaStore&); // referencian sus vectores
+
+public:
+    PersonaStore(); // Almacén vacío
+    explicit PersonaStore(const std::vector<Persona>& personas);
+
+    // Reemplaza el contenido del almacén con las columnas de 'personas'
+    void cargar(const std::vector<Persona>& personas);
+
+    // Usa columnas externas de n filas sin copiarlas. Quien llama debe
+    // mantener viva esa memoria mientras el almacén la referencie.
+    void referenciar(std::size_t n, const std::uint64_t* idExt, const double* ingresosExt,
+                     const double* patrimonioExt, const double* deudasExt,
+                     const std::uint8_t* declaranteExt, const CodigoCiudad* ciudadExt,
+                     const std::int32_t* fechaExt);
+
+    // Crea las columnas en centavos a partir de las columnas double vigentes
+    // (propias o externas); cargar() y referenciar() las descartan. Lanza
+    // std::out_of_range si alguna cantidad no cabe, sin modificar el almacén.
+    void materializarCentavos();
+    bool tieneCentavos() const;
+
+    std::size_t size() const;
+    bool empty() const;
+    bool esExterno() const; // true si referencia memoria ajena
+
+    // --- Acceso a columnas (punteros a datos contiguos de size() elementos) ---
+    const std::uint64_t* getId() const;
+    const double* getIngresosAnuales() const;
+    const double* getPatrimonio() const;
+    const double* getDeudas() const;
+    // Columnas en centavos: nullptr hasta materializarCentavos()
+    const Centavos* getIngresosCentavos() const;
+    const Centavos* getPatrimonioCentavos() const;
+    const Centavos* getDeudasCentavos() const;
+    const std::uint8_t* getDeclaranteRenta() const;
+    const CodigoCiudad* getCiudad() const;
+    const std::int32_t* getFechaNacimiento() const;
+};
+
+#endif // PERSONA_STORE_H
@@ -0,0 +1,205 @@
+#include "rastreo.h"
+
+ConteoAsignaciones::ConteoAsignaciones() : asignaciones(0), bytes(0), liberaciones(0), picoVivo(0) {}
+
+#ifdef RASTREO_MEMORIA
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <malloc.h> // malloc_usable_size
+
+// Contadores de un hilo. Solo su dueño escribe (carga + almacenamiento, sin
+// instrucciones con lock); los demás hilos solo leen para sumar totales.
+struct ContadoresHilo {
+    std::atomic<std::uint64_t> asignaciones;
+    std::atomic<std::uint64_t> bytes;
+    std::atomic<std::uint64_t> liberaciones;
+};
+
+// Ranuras fijas: registrar un hilo no puede asignar memoria (recursión en new)
+static const unsigned MAX_HILOS = 256;
+static ContadoresHilo ranuras[MAX_HILOS];
+static std::atomic<unsigned> ranurasUsadas(0);
+// Hilos sin ranura propia comparten esta, con sumas atómicas
+static ContadoresHilo ranuraCompartida;
+
+static std::atomic<std::int64_t> vivo(0); // Heap vivo del proceso
+
+// Picos de 'vivo' de las mediciones abiertas: cada iniciarRastreo() toma una
+// ventana libre (bit de 'ventanasAbiertas') y cada asignación sube el pico de
+// todas las abiertas
+static const int MAX_VENTANAS = 64;
+static std::atomic<std::int64_t> picos[MAX_VENTANAS];
+static std::atomic<std::uint64_t> ventanasAbiertas(0);
+
+static thread_local ContadoresHilo* propia = nullptr;
+static thread_local bool sinRanura = false;
+
+static inline void sumar(std::atomic<std::uint64_t>& contador, std::uint64_t n, bool compartido) {
+    if (compartido) contador.fetch_add(n, std::memory_order_relaxed);
+    else contador.store(contador.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+static inline ContadoresHilo* contadoresDelHilo() {
+    if (!propia && !sinRanura) {
+        const unsigned r = ranurasUsadas.fetch_add(1, std::memory_order_relaxed);
+        if (r < MAX_HILOS) propia = &ranuras[r];
+        else sinRanura = true;
+    }
+    return propia ? propia : &ranuraCompartida;
+}
+
+static void anotarAsignacion(void* p) {
+    const std::size_t n = malloc_usable_size(p);
+    ContadoresHilo* c = contadoresDelHilo();
+    const bool compartido = c == &ranuraCompartida;
+    sumar(c->asignaciones, 1, compartido);
+    sumar(c->bytes, n, compartido);
+
+    const std::int64_t ahora = vivo.fetch_add(static_cast<std::int64_t>(n), std::memory_order_relaxed) +
+                               static_cast<std::int64_t>(n);
+    std::uint64_t abiertas = ventanasAbiertas.load(std::memory_order_relaxed);
+    while (abiertas != 0) {
+        std::atomic<std::int64_t>& pico = picos[__builtin_ctzll(abiertas)];
+        abiertas &= abiertas - 1;
+        std::int64_t maximo = pico.load(std::memory_order_relaxed);
+        while (ahora > maximo && !pico.compare_exchange_weak(maximo, ahora, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+static void anotarLiberacion(void* p) {
+    if (!p) return;
+    ContadoresHilo* c = contadoresDelHilo();
+    sumar(c->liberaciones, 1, c == &ranuraCompartida);
+    vivo.fetch_sub(static_cast<std::int64_t>(malloc_usable_size(p)), std::memory_order_relaxed);
+}
+
+static void* asignar(std::size_t n) {
+    if (n == 0) n = 1;
+    while (true) {
+        void* p = std::malloc(n);
+        if (p) {
+            anotarAsignacion(p);
+            return p;
+        }
+        std::new_handler manejador = std::get_new_handler();
+        if (!manejador) throw std::bad_alloc();
+        manejador();
+    }
+}
+
+static void* asignarAlineado(std::size_t n, std::size_t alineacion) {
+    if (n == 0) n = 1;
+    while (true) {
+        void* p = nullptr;
+        if (posix_memalign(&p, alineacion < sizeof(void*) ? sizeof(void*) : alineacion, n) == 0) {
+            anotarAsignacion(p);
+            return p;
+        }
+        std::new_handler manejador = std::get_new_handler();
+        if (!manejador) throw std::bad_alloc();
+        manejador();
+    }
+}
+
+static void liberar(void* p) noexcept {
+    anotarLiberacion(p);
+    std::free(p);
+}
+
+// --- Reemplazo de los operadores globales ---
+
+void* operator new(std::size_t n) { return asignar(n); }
+void* operator new[](std::size_t n) { return asignar(n); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    try { return asignar(n); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept {
+    try { return asignar(n); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t n, std::align_val_t a) { return asignarAlineado(n, static_cast<std::size_t>(a)); }
+void* operator new[](std::size_t n, std::align_val_t a) { return asignarAlineado(n, static_cast<std::size_t>(a)); }
+
+void operator delete(void* p) noexcept { liberar(p); }
+void operator delete[](void* p) noexcept { liberar(p); }
+void operator delete(void* p, std::size_t) noexcept { liberar(p); }
+void operator delete[](void* p, std::size_t) noexcept { liberar(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { liberar(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { liberar(p); }
+void operator delete(void* p, std::align_val_t) noexcept { liberar(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { liberar(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { liberar(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { liberar(p); }
+
+bool rastreoActivo() { return true; }
+
+// Suma de los contadores de todos los hilos
+static MarcaRastreo totales() {
+    MarcaRastreo marca;
+    marca.asignaciones = ranuraCompartida.asignaciones.load(std::memory_order_relaxed);
+    marca.bytes = ranuraCompartida.bytes.load(std::memory_order_relaxed);
+    marca.liberaciones = ranuraCompartida.liberaciones.load(std::memory_order_relaxed);
+    const unsigned usadas = ranurasUsadas.load(std::memory_order_relaxed);
+    for (unsigned r = 0; r < usadas && r < MAX_HILOS; ++r) {
+        marca.asignaciones += ranuras[r].asignaciones.load(std::memory_order_relaxed);
+        marca.bytes += ranuras[r].bytes.load(std::memory_order_relaxed);
+        marca.liberaciones += ranuras[r].liberaciones.load(std::memory_order_relaxed);
+    }
+    marca.vivo = vivo.load(std::memory_order_relaxed);
+    return marca;
+}
+
+MarcaRastreo iniciarRastreo() {
+    MarcaRastreo marca = totales();
+    std::uint64_t abiertas = ventanasAbiertas.load(std::memory_order_relaxed);
+    while (~abiertas != 0) {
+        const int v = __builtin_ctzll(~abiertas);
+        if (ventanasAbiertas.compare_exchange_weak(abiertas, abiertas | (std::uint64_t(1) << v),
+                                                   std::memory_order_acq_rel)) {
+            // Una ventana reutilizada no hereda el pico de la medición anterior
+            picos[v].store(marca.vivo, std::memory_order_relaxed);
+            marca.ventana = v;
+            break;
+        }
+    }
+    return marca;
+}
+
+void descartarRastreo(MarcaRastreo& marca) {
+    if (marca.ventana < 0) return;
+    ventanasAbiertas.fetch_and(~(std::uint64_t(1) << marca.ventana), std::memory_order_acq_rel);
+    marca.ventana = -1;
+}
+
+ConteoAsignaciones medirRastreo(MarcaRastreo& inicio) {
+    const MarcaRastreo fin = totales();
+    std::int64_t maximo = inicio.vivo > fin.vivo ? inicio.vivo : fin.vivo; // Sin ventana
+    if (inicio.ventana >= 0) {
+        maximo = picos[inicio.ventana].load(std::memory_order_relaxed);
+        descartarRastreo(inicio);
+    }
+
+    ConteoAsignaciones c;
+    c.asignaciones = fin.asignaciones - inicio.asignaciones;
+    c.bytes = fin.bytes - inicio.bytes;
+    c.liberaciones = fin.liberaciones - inicio.liberaciones;
+    c.picoVivo = maximo - inicio.vivo;
+    return c;
+}
+
+#else
+
+bool rastreoActivo() { return false; }
+
+MarcaRastreo iniciarRastreo() {
+    MarcaRastreo marca = {0, 0, 0, 0, -1};
+    return marca;
+}
+
+ConteoAsignaciones medirRastreo(MarcaRastreo&) { return ConteoAsignaciones(); }
+
+void descartarRastreo(MarcaRastreo&) {}
+
+#endif // RASTREO_MEMORIA
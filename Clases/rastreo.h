@@ -0,0 +1,44 @@
+#ifndef RASTREO_H
+#define RASTREO_H
+
+#include <cstdint>
+
+// --- Rastreo de asignaciones de memoria (opcional) ---
+// Compilando con `make RASTREO=1` (define RASTREO_MEMORIA) se reemplazan los
+// operator new/delete globales para contar asignaciones con contadores por
+// hilo y el heap vivo del proceso. Sin esa opción las funciones existen pero
+// no miden nada (rastreoActivo() == false) y no hay costo por asignación.
+// Los bytes son los utilizables del bloque (malloc_usable_size), que pueden
+// superar lo pedido.
+
+// Totales acumulados del proceso (todos los hilos) en un instante
+struct MarcaRastreo {
+    std::uint64_t asignaciones;
+    std::uint64_t bytes;
+    std::uint64_t liberaciones;
+    std::int64_t vivo;          // Bytes en uso en ese instante
+    int ventana = -1;           // Ranura con el pico de esta medición (-1 = ninguna)
+};
+
+// Diferencia entre dos instantes
+struct ConteoAsignaciones {
+    std::uint64_t asignaciones; // Llamadas a operator new
+    std::uint64_t bytes;        // Bytes asignados
+    std::uint64_t liberaciones; // Llamadas a operator delete
+    std::int64_t picoVivo;      // Máximo crecimiento del heap vivo sobre el inicio
+
+    ConteoAsignaciones();
+};
+
+bool rastreoActivo();
+
+// Toma los totales y abre una ventana con su propio pico de heap vivo, de modo
+// que las mediciones anidadas o concurrentes no se pisan el pico (hasta 64
+// abiertas a la vez; sin ranura libre el pico se estima con los extremos)
+MarcaRastreo iniciarRastreo();
+// Asignaciones desde 'inicio' y pico de heap vivo de su ventana, que se cierra
+ConteoAsignaciones medirRastreo(MarcaRastreo& inicio);
+// Cierra la ventana de una marca que no se va a medir
+void descartarRastreo(MarcaRastreo& marca);
+
+#endif // RASTREO_H
@@ -0,0 +1,130 @@
+#include "simd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// Compara según el extremo buscado (estricto: en empates se queda el anterior)
+template <bool Maximo>
+static inline bool mejorQue(double a, double b) {
+    return Maximo ? b < a : a < b;
+}
+
+// Recorrido escalar desde 'desde' partiendo del candidato 'mejor'
+template <bool Maximo>
+static std::size_t argExtremoEscalar(const double* datos, std::size_t n,
+                                     std::size_t desde, std::size_t mejor) {
+    for (std::size_t i = desde; i < n; ++i) {
+        if (mejorQue<Maximo>(datos[i], datos[mejor])) mejor = i;
+    }
+    return mejor;
+}
+
+template <bool Maximo>
+static std::size_t argExtremoEscalar(const double* datos, std::size_t n) {
+    return argExtremoEscalar<Maximo>(datos, n, 1, 0);
+}
+
+#ifdef SIMD_X86
+// Reduce los carriles de un vector: mejor valor y, en empate, menor posición.
+// Luego continúa en escalar con la cola que no llenó un vector completo.
+template <bool Maximo>
+static std::size_t reducirCarriles(const double* valores, const double* posiciones, int carriles,
+                                   const double* datos, std::size_t n, std::size_t desde) {
+    int elegido = 0;
+    for (int c = 1; c < carriles; ++c) {
+        if (mejorQue<Maximo>(valores[c], valores[elegido]) ||
+            (valores[c] == valores[elegido] && posiciones[c] < posiciones[elegido])) {
+            elegido = c;
+        }
+    }
+    return argExtremoEscalar<Maximo>(datos, n, desde, static_cast<std::size_t>(posiciones[elegido]));
+}
+
+// Cada carril guarda su mejor valor y su posición (como double, exacto hasta 2^53).
+// La comparación estricta conserva la primera aparición dentro de cada carril.
+template <bool Maximo>
+__attribute__((target("avx2")))
+static std::size_t argExtremoAVX2(const double* datos, std::size_t n) {
+    if (n < 8) return argExtremoEscalar<Maximo>(datos, n);
+
+    __m256d mejor = _mm256_loadu_pd(datos);
+    __m256d posicion = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+    __m256d actual = posicion;
+    const __m256d paso = _mm256_set1_pd(4.0);
+
+    std::size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        actual = _mm256_add_pd(actual, paso);
+        __m256d v = _mm256_loadu_pd(datos + i);
+        __m256d mascara = Maximo ? _mm256_cmp_pd(v, mejor, _CMP_GT_OQ)
+                                 : _mm256_cmp_pd(v, mejor, _CMP_LT_OQ);
+        mejor = _mm256_blendv_pd(mejor, v, mascara);
+        posicion = _mm256_blendv_pd(posicion, actual, mascara);
+    }
+
+    double valores[4], posiciones[4];
+    _mm256_storeu_pd(valores, mejor);
+    _mm256_storeu_pd(posiciones, posicion);
+    return reducirCarriles<Maximo>(valores, posiciones, 4, datos, n, i);
+}
+
+template <bool Maximo>
+__attribute__((target("sse4.1")))
+static std::size_t argExtremoSSE41(const double* datos, std::size_t n) {
+    if (n < 4) return argExtremoEscalar<Maximo>(datos, n);
+
+    __m128d mejor = _mm_loadu_pd(datos);
+    __m128d posicion = _mm_set_pd(1.0, 0.0);
+    __m128d actual = posicion;
+    const __m128d paso = _mm_set1_pd(2.0);
+
+    std::size_t i = 2;
+    for (; i + 2 <= n; i += 2) {
+        actual = _mm_add_pd(actual, paso);
+        __m128d v = _mm_loadu_pd(datos + i);
+        __m128d mascara = Maximo ? _mm_cmpgt_pd(v, mejor) : _mm_cmplt_pd(v, mejor);
+        mejor = _mm_blendv_pd(mejor, v, mascara);
+        posicion = _mm_blendv_pd(posicion, actual, mascara);
+    }
+
+    double valores[2], posiciones[2];
+    _mm_storeu_pd(valores, mejor);
+    _mm_storeu_pd(posiciones, posicion);
+    return reducirCarriles<Maximo>(valores, posiciones, 2, datos, n, i);
+}
+#endif
+
+// Implementación elegida para esta CPU (se decide en el primer uso)
+typedef std::size_t (*FuncionArgExtremo)(const double*, std::size_t);
+
+struct Despacho {
+    FuncionArgExtremo maximo;
+    FuncionArgExtremo minimo;
+    const char* nivel;
+
+    Despacho() : maximo(argExtremoEscalar<true>), minimo(argExtremoEscalar<false>), nivel("escalar") {
+#ifdef SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            maximo = argExtremoAVX2<true>;
+            minimo = argExtremoAVX2<false>;
+            nivel = "avx2";
+        } else if (__builtin_cpu_supports("sse4.1")) {
+            maximo = argExtremoSSE41<true>;
+            minimo = argExtremoSSE41<false>;
+            nivel = "sse4.1";
+        }
+#endif
+    }
+};
+
+static const Despacho& despacho() {
+    static const Despacho d;
+    return d;
+}
+
+std::size_t argMaxDouble(const double* datos, std::size_t n) { return despacho().maximo(datos, n); }
+std::size_t argMinDouble(const double* datos, std::size_t n) { return despacho().minimo(datos, n); }
+const char* nivelSIMD() { return despacho().nivel; }
@@ -0,0 +1,17 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstddef>
+
+// --- Núcleos vectoriales de argmax/argmin sobre columnas double contiguas ---
+// La implementación (AVX2, SSE4.1 o escalar) se elige una vez en tiempo de
+// ejecución según la CPU. Todas devuelven la primera posición del extremo,
+// igual que std::max_element / std::min_element. Requieren n > 0.
+
+std::size_t argMaxDouble(const double* datos, std::size_t n);
+std::size_t argMinDouble(const double* datos, std::size_t n);
+
+// Nombre de la implementación elegida ("avx2", "sse4.1" o "escalar")
+const char* nivelSIMD();
+
+#endif // SIMD_H
@@ -0,0 +1,309 @@
+#include "snapshot.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+#include "ciudades.h"
+
+// Secciones del archivo, en el orden en que se escriben
+enum Seccion {
+    SEC_ID, SEC_INGRESOS, SEC_PATRIMONIO, SEC_DEUDAS, SEC_FECHA, SEC_CIUDAD, SEC_DECLARANTE,
+    SEC_INICIO_NOMBRE, SEC_INICIO_APELLIDO, SEC_INICIO_CIUDAD, SEC_MONTICULO,
+    TOTAL_SECCIONES
+};
+
+struct CabeceraSnapshot {
+    char firma[8];                      // "PERSNAPS"
+    std::uint32_t version;
+    std::uint32_t ciudades;             // Nombres de ciudad guardados
+    std::uint64_t filas;
+    std::uint64_t bytesMonticulo;
+    std::uint64_t seccion[TOTAL_SECCIONES]; // Desplazamiento desde el inicio del archivo
+};
+
+static const char FIRMA_SNAPSHOT[8] = {'P', 'E', 'R', 'S', 'N', 'A', 'P', 'S'};
+static const std::uint32_t VERSION_SNAPSHOT = 1;
+static const std::uint64_t ALINEACION = 64; // Una línea de caché por columna
+
+static std::uint64_t alinear(std::uint64_t desplazamiento) {
+    return (desplazamiento + ALINEACION - 1) / ALINEACION * ALINEACION;
+}
+
+// Bytes que ocupa cada sección dados filas, ciudades y tamaño del montículo
+static std::uint64_t bytesSeccion(int s, std::uint64_t filas, std::uint64_t ciudades,
+                                  std::uint64_t monticulo) {
+    switch (s) {
+        case SEC_ID: return filas * sizeof(std::uint64_t);
+        case SEC_INGRESOS:
+        case SEC_PATRIMONIO:
+        case SEC_DEUDAS: return filas * sizeof(double);
+        case SEC_FECHA: return filas * sizeof(std::int32_t);
+        case SEC_CIUDAD: return filas * sizeof(CodigoCiudad);
+        case SEC_DECLARANTE: return filas * sizeof(std::uint8_t);
+        case SEC_INICIO_NOMBRE:
+        case SEC_INICIO_APELLIDO: return (filas + 1) * sizeof(std::uint64_t);
+        case SEC_INICIO_CIUDAD: return (ciudades + 1) * sizeof(std::uint64_t);
+        default: return monticulo;
+    }
+}
+
+// --- Escritura ---
+
+class EscritorSnapshot {
+public:
+    EscritorSnapshot(const std::string& ruta)
+        : archivo(std::fopen(ruta.c_str(), "wb")), ruta(ruta), posicion(0) {
+        if (!archivo) throw std::runtime_error("No se pudo abrir " + ruta);
+    }
+    ~EscritorSnapshot() {
+        if (archivo) std::fclose(archivo);
+    }
+
+    void escribir(const void* datos, std::size_t bytes) {
+        if (bytes && std::fwrite(datos, 1, bytes, archivo) != bytes) {
+            throw std::runtime_error("Error escribiendo en " + ruta);
+        }
+        posicion += bytes;
+    }
+
+    // Rellena con ceros hasta 'destino'
+    void rellenarHasta(std::uint64_t destino) {
+        static const char ceros[ALINEACION] = {};
+        while (posicion < destino) {
+            escribir(ceros, static_cast<std::size_t>(std::min<std::uint64_t>(destino - posicion, ALINEACION)));
+        }
+    }
+
+    // Escribe una columna extrayendo el campo de cada persona, por bloques
+    template <typename T, typename Extraer>
+    void columna(const std::vector<Persona>& personas, Extraer extraer) {
+        std::vector<T> bloque;
+        bloque.reserve(4096);
+        for (std::size_t i = 0; i < personas.size(); ++i) {
+            bloque.push_back(extraer(personas[i]));
+            if (bloque.size() == 4096) {
+                escribir(bloque.data(), bloque.size() * sizeof(T));
+                bloque.clear();
+            }
+        }
+        escribir(bloque.data(), bloque.size() * sizeof(T));
+    }
+
+    void cerrar() {
+        const bool error = std::fclose(archivo) != 0;
+        archivo = nullptr;
+        if (error) throw std::runtime_error("Error cerrando " + ruta);
+    }
+
+private:
+    std::FILE* archivo;
+    std::string ruta;
+    std::uint64_t posicion;
+};
+
+// Escribe los desplazamientos acumulados de una lista de textos, empezando en 'base'
+template <typename Texto>
+static std::uint64_t escribirInicios(EscritorSnapshot& escritor, std::size_t cantidad,
+                                     Texto texto, std::uint64_t base) {
+    std::vector<std::uint64_t> bloque;
+    bloque.reserve(4096);
+    bloque.push_back(base);
+    for (std::size_t i = 0; i < cantidad; ++i) {
+        base += texto(i).size();
+        bloque.push_back(base);
+        if (bloque.size() == 4096) {
+            escritor.escribir(bloque.data(), bloque.size() * sizeof(std::uint64_t));
+            bloque.clear();
+        }
+    }
+    escritor.escribir(bloque.data(), bloque.size() * sizeof(std::uint64_t));
+    return base;
+}
+
+void guardarSnapshot(const std::string& ruta, const std::vector<Persona>& personas) {
+    const std::uint64_t filas = personas.size();
+    const std::uint32_t ciudades = static_cast<std::uint32_t>(totalCiudades());
+
+    // Primero los tamaños, para fijar la cabecera antes de escribir
+    std::uint64_t bytesNombres = 0, bytesApellidos = 0, bytesCiudades = 0;
+    for (std::size_t i = 0; i < personas.size(); ++i) {
+        bytesNombres += personas[i].getNombre().size();
+        bytesApellidos += personas[i].getApellido().size();
+    }
+    for (std::uint32_t c = 0; c < ciudades; ++c) {
+        bytesCiudades += nombreCiudad(static_cast<CodigoCiudad>(c)).size();
+    }
+
+    CabeceraSnapshot cabecera;
+    std::memset(&cabecera, 0, sizeof(cabecera));
+    std::memcpy(cabecera.firma, FIRMA_SNAPSHOT, sizeof(FIRMA_SNAPSHOT));
+    cabecera.version = VERSION_SNAPSHOT;
+    cabecera.ciudades = ciudades;
+    cabecera.filas = filas;
+    cabecera.bytesMonticulo = bytesNombres + bytesApellidos + bytesCiudades;
+
+    std::uint64_t desplazamiento = alinear(sizeof(CabeceraSnapshot));
+    for (int s = 0; s < TOTAL_SECCIONES; ++s) {
+        cabecera.seccion[s] = desplazamiento;
+        desplazamiento = alinear(desplazamiento + bytesSeccion(s, filas, ciudades, cabecera.bytesMonticulo));
+    }
+
+    EscritorSnapshot escritor(ruta);
+    escritor.escribir(&cabecera, sizeof(cabecera));
+
+    escritor.rellenarHasta(cabecera.seccion[SEC_ID]);
+    escritor.columna<std::uint64_t>(personas, [](const Persona& p) { return p.getId(); });
+    escritor.rellenarHasta(cabecera.seccion[SEC_INGRESOS]);
+    escritor.columna<double>(personas, [](const Persona& p) { return p.getIngresosAnuales(); });
+    escritor.rellenarHasta(cabecera.seccion[SEC_PATRIMONIO]);
+    escritor.columna<double>(personas, [](const Persona& p) { return p.getPatrimonio(); });
+    escritor.rellenarHasta(cabecera.seccion[SEC_DEUDAS]);
+    escritor.columna<double>(personas, [](const Persona& p) { return p.getDeudas(); });
+    escritor.rellenarHasta(cabecera.seccion[SEC_FECHA]);
+    escritor.columna<std::int32_t>(personas, [](const Persona& p) { return p.getFechaEmpaquetada(); });
+    escritor.rellenarHasta(cabecera.seccion[SEC_CIUDAD]);
+    escritor.columna<CodigoCiudad>(personas, [](const Persona& p) { return p.getCodigoCiudad(); });
+    escritor.rellenarHasta(cabecera.seccion[SEC_DECLARANTE]);
+    escritor.columna<std::uint8_t>(personas, [](const Persona& p) {
+        return static_cast<std::uint8_t>(p.getDeclaranteRenta() ? 1 : 0);
+    });
+
+    // Montículo: nombres, luego apellidos, luego ciudades
+    escritor.rellenarHasta(cabecera.seccion[SEC_INICIO_NOMBRE]);
+    std::uint64_t base = escribirInicios(escritor, personas.size(),
+        [&](std::size_t i) { return personas[i].getNombre(); }, 0);
+    escritor.rellenarHasta(cabecera.seccion[SEC_INICIO_APELLIDO]);
+    base = escribirInicios(escritor, personas.size(),
+        [&](std::size_t i) { return personas[i].getApellido(); }, base);
+    escritor.rellenarHasta(cabecera.seccion[SEC_INICIO_CIUDAD]);
+    escribirInicios(escritor, ciudades,
+        [](std::size_t c) -> const std::string& { return nombreCiudad(static_cast<CodigoCiudad>(c)); }, base);
+
+    escritor.rellenarHasta(cabecera.seccion[SEC_MONTICULO]);
+    for (std::size_t i = 0; i < personas.size(); ++i) {
+        const std::string_view nombre = personas[i].getNombre();
+        escritor.escribir(nombre.data(), nombre.size());
+    }
+    for (std::size_t i = 0; i < personas.size(); ++i) {
+        const std::string_view apellido = personas[i].getApellido();
+        escritor.escribir(apellido.data(), apellido.size());
+    }
+    for (std::uint32_t c = 0; c < ciudades; ++c) {
+        const std::string& nombre = nombreCiudad(static_cast<CodigoCiudad>(c));
+        escritor.escribir(nombre.data(), nombre.size());
+    }
+
+    escritor.cerrar();
+}
+
+// --- Lectura con mmap ---
+
+SnapshotMapeado::SnapshotMapeado(const std::string& ruta)
+    : mapa(MAP_FAILED), tamano(0), filas(0) {
+    const int fd = open(ruta.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("No se pudo abrir " + ruta);
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(CabeceraSnapshot)) {
+        close(fd);
+        throw std::runtime_error("Snapshot inválido: " + ruta);
+    }
+    tamano = static_cast<std::size_t>(info.st_size);
+    mapa = mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // El mapeo se mantiene sin el descriptor
+    if (mapa == MAP_FAILED) throw std::runtime_error("No se pudo mapear " + ruta);
+
+    try {
+        const char* base = static_cast<const char*>(mapa);
+        CabeceraSnapshot cabecera;
+        std::memcpy(&cabecera, base, sizeof(cabecera));
+
+        if (std::memcmp(cabecera.firma, FIRMA_SNAPSHOT, sizeof(FIRMA_SNAPSHOT)) != 0) {
+            throw std::runtime_error("No es un snapshot de personas: " + ruta);
+        }
+        if (cabecera.version != VERSION_SNAPSHOT) {
+            throw std::runtime_error("Versión de snapshot no soportada: " + std::to_string(cabecera.version));
+        }
+        // Cada sección alineada y dentro del archivo
+        for (int s = 0; s < TOTAL_SECCIONES; ++s) {
+            const std::uint64_t bytes = bytesSeccion(s, cabecera.filas, cabecera.ciudades, cabecera.bytesMonticulo);
+            if (cabecera.seccion[s] % ALINEACION != 0 || cabecera.seccion[s] > tamano ||
+                bytes > tamano - cabecera.seccion[s]) {
+                throw std::runtime_error("Snapshot truncado o corrupto: " + ruta);
+            }
+        }
+
+        filas = static_cast<std::size_t>(cabecera.filas);
+        id = reinterpret_cast<const std::uint64_t*>(base + cabecera.seccion[SEC_ID]);
+        ingresos = reinterpret_cast<const double*>(base + cabecera.seccion[SEC_INGRESOS]);
+        patrimonio = reinterpret_cast<const double*>(base + cabecera.seccion[SEC_PATRIMONIO]);
+        deudas = reinterpret_cast<const double*>(base + cabecera.seccion[SEC_DEUDAS]);
+        fecha = reinterpret_cast<const std::int32_t*>(base + cabecera.seccion[SEC_FECHA]);
+        ciudad = reinterpret_cast<const CodigoCiudad*>(base + cabecera.seccion[SEC_CIUDAD]);
+        declarante = reinterpret_cast<const std::uint8_t*>(base + cabecera.seccion[SEC_DECLARANTE]);
+        inicioNombre = reinterpret_cast<const std::uint64_t*>(base + cabecera.seccion[SEC_INICIO_NOMBRE]);
+        inicioApellido = reinterpret_cast<const std::uint64_t*>(base + cabecera.seccion[SEC_INICIO_APELLIDO]);
+        monticulo = base + cabecera.seccion[SEC_MONTICULO];
+
+        // Los códigos guardados se traducen al diccionario de esta sesión
+        const std::uint64_t* inicioCiudad =
+            reinterpret_cast<const std::uint64_t*>(base + cabecera.seccion[SEC_INICIO_CIUDAD]);
+        std::vector<CodigoCiudad> traduccion(cabecera.ciudades);
+        bool identica = true;
+        for (std::uint32_t c = 0; c < cabecera.ciudades; ++c) {
+            traduccion[c] = codigoCiudad(std::string(texto(inicioCiudad, c)));
+            if (traduccion[c] != c) identica = false;
+        }
+
+        // Un código fuera del diccionario indexaría fuera de los acumuladores
+        for (std::size_t i = 0; i < filas; ++i) {
+            if (ciudad[i] >= cabecera.ciudades) {
+                throw std::runtime_error("Código de ciudad inválido en " + ruta);
+            }
+        }
+        if (!identica) {
+            ciudadTraducida.resize(filas);
+            for (std::size_t i = 0; i < filas; ++i) ciudadTraducida[i] = traduccion[ciudad[i]];
+            ciudad = ciudadTraducida.data();
+        }
+    } catch (...) {
+        munmap(mapa, tamano);
+        throw;
+    }
+}
+
+SnapshotMapeado::~SnapshotMapeado() {
+    munmap(mapa, tamano);
+}
+
+std::size_t SnapshotMapeado::size() const { return filas; }
+std::size_t SnapshotMapeado::bytes() const { return tamano; }
+
+void SnapshotMapeado::vincular(PersonaStore& store) const {
+    store.referenciar(filas, id, ingresos, patrimonio, deudas, declarante, ciudad, fecha);
+}
+
+std::string_view SnapshotMapeado::texto(const std::uint64_t* inicios, std::size_t i) const {
+    const std::uint64_t inicio = inicios[i];
+    const std::uint64_t fin = inicios[i + 1];
+    const std::uint64_t limite = static_cast<std::uint64_t>(tamano - (monticulo - static_cast<const char*>(mapa)));
+    if (inicio > fin || fin > limite) throw std::runtime_error("Cadena fuera del snapshot");
+    return std::string_view(monticulo + inicio, static_cast<std::size_t>(fin - inicio));
+}
+
+Persona SnapshotMapeado::persona(std::size_t i) const {
+    if (i >= filas) throw std::out_of_range("Fila fuera del snapshot");
+    return Persona(texto(inicioNombre, i), texto(inicioApellido, i), id[i], ciudad[i], fecha[i],
+                   ingresos[i], patrimonio[i], deudas[i], declarante[i] != 0);
+}
+
+std::vector<Persona> SnapshotMapeado::materializar() const {
+    std::vector<Persona> personas;
+    personas.reserve(filas);
+    for (std::size_t i = 0; i < filas; ++i) personas.push_back(persona(i));
+    return personas;
+}
@@ -0,0 +1,70 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "persona.h"
+#include "persona_store.h"
+
+// --- Snapshot binario del dataset ---
+// Formato (versión 1, orden de bytes de la máquina):
+//   cabecera fija (CabeceraSnapshot)
+//   columnas numéricas de ancho fijo, una tras otra, alineadas a 64 bytes:
+//     id (uint64), ingresos, patrimonio, deudas (double), fecha (int32),
+//     ciudad (uint16), declarante (uint8)
+//   desplazamientos de cadenas (uint64, filas + 1 cada uno) para nombre y
+//   apellido, y (ciudades + 1) para los nombres de ciudad
+//   montículo de cadenas: todos los bytes de texto, sin separadores
+// Al abrirlo se mapea con mmap y las columnas se consultan en sitio.
+
+// Escribe 'personas' en 'ruta'. Lanza std::runtime_error si falla la escritura.
+void guardarSnapshot(const std::string& ruta, const std::vector<Persona>& personas);
+
+// Snapshot abierto con mmap (solo lectura). Mantiene el mapeo mientras vive.
+class SnapshotMapeado {
+public:
+    // Mapea y valida 'ruta'. Lanza std::runtime_error si no es un snapshot válido.
+    explicit SnapshotMapeado(const std::string& ruta);
+    ~SnapshotMapeado();
+
+    std::size_t size() const;
+    std::size_t bytes() const; // Tamaño del archivo mapeado
+
+    // Apunta 'store' a las columnas mapeadas (sin copiar)
+    void vincular(PersonaStore& store) const;
+
+    // Construye la persona de la fila i (copia sus cadenas)
+    Persona persona(std::size_t i) const;
+    // Copia todo el snapshot a un vector de Persona
+    std::vector<Persona> materializar() const;
+
+private:
+    SnapshotMapeado(const SnapshotMapeado&);            // No copiable
+    SnapshotMapeado& operator=(const SnapshotMapeado&);
+
+    std::string_view texto(const std::uint64_t* inicios, std::size_t i) const; // Vista sobre el mapa
+
+    void* mapa;
+    std::size_t tamano;
+    std::size_t filas;
+
+    const std::uint64_t* id;
+    const double* ingresos;
+    const double* patrimonio;
+    const double* deudas;
+    const std::int32_t* fecha;
+    const CodigoCiudad* ciudad;
+    const std::uint8_t* declarante;
+    const std::uint64_t* inicioNombre;
+    const std::uint64_t* inicioApellido;
+    const char* monticulo;
+
+    // Códigos de ciudad traducidos al diccionario actual, solo si difieren
+    std::vector<CodigoCiudad> ciudadTraducida;
+};
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,88 @@
+#include "sumidero.h"
+#include <stdexcept>
+#include <utility>
+#include "analitica.h"
+#include "paralelo.h"
+#include "ciudades.h"
+
+// --- SumideroMemoria ---
+
+SumideroMemoria::SumideroMemoria(std::vector<Persona>& destino) : destino(destino) {}
+
+void SumideroMemoria::consumir(std::vector<Persona>& lote, std::uint64_t) {
+    destino.reserve(destino.size() + lote.size());
+    for (std::size_t i = 0; i < lote.size(); ++i) {
+        destino.push_back(std::move(lote[i]));
+    }
+}
+
+// --- SumideroArchivo ---
+
+SumideroArchivo::SumideroArchivo(const std::string& ruta, PoolHilos& pool)
+    : escritor(ruta, pool), escritas(0) {}
+
+void SumideroArchivo::consumir(std::vector<Persona>& lote, std::uint64_t) {
+    escritor.escribir(lote);
+    escritas += lote.size();
+}
+
+void SumideroArchivo::finalizar() {
+    escritor.cerrar();
+}
+
+std::uint64_t SumideroArchivo::getEscritas() const { return escritas; }
+
+// --- SumideroAgregado ---
+
+ExtremosGrupo::ExtremosGrupo() : total(0), declarantes(0) {}
+
+SumideroAgregado::SumideroAgregado(PoolHilos& pool) : pool(pool) {}
+
+// Mezcla los extremos del lote (índices sobre 'personas'). Los lotes llegan en
+// orden, así que solo se reemplaza con mejora estricta.
+void SumideroAgregado::mezclar(ExtremosGrupo& destino, const AcumuladoGrupo& lote,
+                               const std::vector<Persona>& personas) {
+    if (lote.total == 0) return;
+    const bool vacio = destino.total == 0;
+
+    const Persona& longeva = personas[lote.masLongeva];
+    const Persona& maxPatri = personas[lote.maxPatrimonio];
+    const Persona& minPatri = personas[lote.minPatrimonio];
+    const Persona& maxDeuda = personas[lote.maxDeuda];
+
+    if (vacio || longeva.getFechaEmpaquetada() < destino.masLongeva.getFechaEmpaquetada())
+        destino.masLongeva = longeva;
+    if (vacio || destino.maxPatrimonio.getPatrimonio() < maxPatri.getPatrimonio())
+        destino.maxPatrimonio = maxPatri;
+    if (vacio || minPatri.getPatrimonio() < destino.minPatrimonio.getPatrimonio())
+        destino.minPatrimonio = minPatri;
+    if (vacio || destino.maxDeuda.getDeudas() < maxDeuda.getDeudas())
+        destino.maxDeuda = maxDeuda;
+
+    destino.total += lote.total;
+    destino.declarantes += lote.declarantes;
+}
+
+void SumideroAgregado::consumir(std::vector<Persona>& lote, std::uint64_t) {
+    columnas.cargar(lote);
+    const ReporteAnalitico reporte = generarReporteParalelo(columnas, pool);
+
+    // Ciudades registradas después del primer lote también se acumulan
+    if (porCiudad.size() < reporte.porCiudad.size()) porCiudad.resize(reporte.porCiudad.size());
+
+    mezclar(pais, reporte.pais, lote);
+    for (std::size_t codigo = 0; codigo < reporte.porCiudad.size(); ++codigo) {
+        mezclar(porCiudad[codigo], reporte.porCiudad[codigo], lote);
+    }
+    for (int g = 0; g < 3; ++g) {
+        mezclar(porGrupoDIAN[g], reporte.porGrupoDIAN[g], lote);
+    }
+}
+
+const ExtremosGrupo& SumideroAgregado::getPais() const { return pais; }
+const std::vector<ExtremosGrupo>& SumideroAgregado::getPorCiudad() const { return porCiudad; }
+
+const ExtremosGrupo& SumideroAgregado::getGrupoDIAN(int grupo) const {
+    if (grupo < 0 || grupo > 2) throw std::out_of_range("Grupo DIAN inválido");
+    return porGrupoDIAN[grupo];
+}
@@ -0,0 +1,92 @@
+#ifndef SUMIDERO_H
+#define SUMIDERO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "csv.h"
+#include "persona.h"
+#include "persona_store.h"
+
+class PoolHilos;
+struct AcumuladoGrupo;
+
+// Destinos de la generación en flujo (ver generarEnFlujo en generador.h).
+// El generador entrega lotes consecutivos de personas; cada sumidero decide
+// qué conservar de ellos. 'primera' es la posición global de lote[0].
+class SumideroPersonas {
+public:
+    virtual ~SumideroPersonas() {}
+
+    // Procesa un lote. Puede mover su contenido: el generador lo sobrescribe después.
+    virtual void consumir(std::vector<Persona>& lote, std::uint64_t primera) = 0;
+    // Se llama una vez después del último lote
+    virtual void finalizar() {}
+};
+
+// Acumula todas las personas en memoria (equivale a generarColeccionParalela)
+class SumideroMemoria : public SumideroPersonas {
+public:
+    explicit SumideroMemoria(std::vector<Persona>& destino);
+    void consumir(std::vector<Persona>& lote, std::uint64_t primera);
+
+private:
+    std::vector<Persona>& destino;
+};
+
+// Escribe las personas en un archivo CSV con el formato de csv.h, así el
+// resultado se puede cargar con importarCSV (opción 14 del menú). Cada lote
+// se formatea en paralelo y se añade al final; nunca se conserva más de un lote.
+class SumideroArchivo : public SumideroPersonas {
+public:
+    SumideroArchivo(const std::string& ruta, PoolHilos& pool); // Lanza std::runtime_error si no abre
+
+    void consumir(std::vector<Persona>& lote, std::uint64_t primera);
+    void finalizar(); // Cierra el archivo
+
+    std::uint64_t getEscritas() const;
+
+private:
+    EscritorCSV escritor;
+    std::uint64_t escritas;
+};
+
+// Extremos de un grupo a lo largo de todo el flujo. Guarda copias de las
+// personas porque los lotes no sobreviven a la generación.
+struct ExtremosGrupo {
+    std::uint64_t total;
+    std::uint64_t declarantes;
+    Persona masLongeva;
+    Persona maxPatrimonio;
+    Persona minPatrimonio;
+    Persona maxDeuda;
+
+    ExtremosGrupo();
+};
+
+// Calcula el reporte de la opción 4 sobre el flujo completo con memoria
+// acotada: cada lote pasa por el motor analítico y sus extremos se mezclan
+// con los acumulados. En empates gana la persona de menor posición global.
+class SumideroAgregado : public SumideroPersonas {
+public:
+    explicit SumideroAgregado(PoolHilos& pool);
+    void consumir(std::vector<Persona>& lote, std::uint64_t primera);
+
+    const ExtremosGrupo& getPais() const;
+    const std::vector<ExtremosGrupo>& getPorCiudad() const; // Indexado por código de ciudad
+    const ExtremosGrupo& getGrupoDIAN(int grupo) const;     // 0, 1, 2 = A, B, C
+
+private:
+    void mezclar(ExtremosGrupo& destino, const AcumuladoGrupo& lote,
+                 const std::vector<Persona>& personas);
+
+    PoolHilos& pool;
+    PersonaStore columnas; // Se reutiliza entre lotes
+    ExtremosGrupo pais;
+    std::vector<ExtremosGrupo> porCiudad;
+    ExtremosGrupo porGrupoDIAN[3];
+};
+
+#endif // SUMIDERO_H
@@ -5,6 +5,9 @@
 #include "persona.h"
 #include "generador.h"
 #include "monitor.h"
+#include "persona_compacta.h"
+#include <chrono>
+#include <iomanip>
 #include <ctime>
 
 /**
@@ -25,9 +28,38 @@ void mostrarMenu() {
     std::cout << "\n6. Mostrar estadísticas de rendimiento";
     std::cout << "\n7. Exportar estadísticas a CSV";
     std::cout << "\n8. Salir";
+    std::cout << "\n9. Comparar con registro compacto (32 bytes)";
     std::cout << "\nSeleccione una opción: ";
 }
 
+// Tiempo en milisegundos que tarda una consulta (sin tocar el cronómetro del Monitor)
+template <typename Consulta>
+double medirConsulta(Consulta consulta) {
+    const auto inicio = std::chrono::high_resolution_clock::now();
+    consulta();
+    const std::chrono::duration<double, std::milli> duracion = std::chrono::high_resolution_clock::now() - inicio;
+    return duracion.count();
+}
+
+// Mismas claves y mismo tamaño por grupo en ambas agrupaciones
+template <typename MapaA, typename MapaB>
+bool mismosGrupos(const MapaA& a, const MapaB& b) {
+    if (a.size() != b.size()) return false;
+    auto itB = b.begin();
+    for (const auto& par : a) {
+        if (par.first != itB->first || par.second.size() != itB->second.size()) return false;
+        ++itB;
+    }
+    return true;
+}
+
+void mostrarComparacion(const std::string& consulta, double original, double compacta, bool coincide) {
+    std::cout << std::left << std::setw(26) << consulta << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << original << std::setw(12) << compacta
+              << std::setw(9) << std::setprecision(1) << (compacta > 0 ? original / compacta : 0) << "x"
+              << (coincide ? "   sí" : "   NO") << "\n";
+}
+
 /**
  * Punto de entrada principal del programa.
  *
@@ -341,6 +373,83 @@ int main() {
                 std::cout << "Saliendo...\n";
                 break;
 
+            case 9: { // Comparar huella y velocidad de recorrido con el registro compacto
+                if (!personas || personas->empty()) {
+                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                    break;
+                }
+
+                monitor.iniciar_tiempo();
+                memoria_inicio = monitor.obtener_memoria();
+
+                ColeccionCompacta compacta;
+                try {
+                    const double tiempo_compactar = medirConsulta([&] { compacta = compactar(*personas); });
+                    std::cout << "\nCompactadas " << compacta.personas.size() << " personas en "
+                              << std::fixed << std::setprecision(3) << tiempo_compactar << " ms\n";
+                } catch (const std::exception& e) {
+                    std::cout << "Error al compactar: " << e.what() << "\n";
+                    break;
+                }
+
+                const size_t huellaOriginal = huellaPersonas(*personas);
+                const size_t huellaNueva = huellaCompacta(compacta);
+                std::cout << "Persona: " << sizeof(Persona) << " B/registro, "
+                          << huellaOriginal / 1024 << " KB en total (con textos en heap)\n";
+                std::cout << "PersonaCompacta: " << sizeof(PersonaCompacta) << " B/registro, "
+                          << huellaNueva / 1024 << " KB en total (con tablas)\n";
+
+                std::cout << "\n" << std::left << std::setw(26) << "Consulta" << std::right
+                          << std::setw(12) << "Persona ms" << std::setw(12) << "Compacta ms"
+                          << std::setw(10) << "Mejora" << "   Coincide\n";
+
+                Persona p;
+                PersonaCompacta r;
+                double original = medirConsulta([&] { personaMaxLongeva(*personas, p); });
+                double nueva = medirConsulta([&] { personaMaxLongeva(compacta.personas, r); });
+                mostrarComparacion("Más longeva", original, nueva, p.id == std::to_string(r.id));
+
+                original = medirConsulta([&] { personaMaxPatrimonio(*personas, p); });
+                nueva = medirConsulta([&] { personaMaxPatrimonio(compacta.personas, r); });
+                mostrarComparacion("Mayor patrimonio", original, nueva, p.id == std::to_string(r.id));
+
+                original = medirConsulta([&] { personaMinPatrimonio(*personas, p); });
+                nueva = medirConsulta([&] { personaMinPatrimonio(compacta.personas, r); });
+                mostrarComparacion("Menor patrimonio", original, nueva, p.id == std::to_string(r.id));
+
+                original = medirConsulta([&] { personaMaxDeuda(*personas, p); });
+                nueva = medirConsulta([&] { personaMaxDeuda(compacta.personas, r); });
+                mostrarComparacion("Mayor deuda", original, nueva, p.id == std::to_string(r.id));
+
+                std::map<std::string, std::vector<Persona>> gruposOriginal;
+                std::map<std::string, std::vector<PersonaCompacta>> gruposCompacta;
+                original = medirConsulta([&] { agruparPorCiudad(*personas, gruposOriginal); });
+                nueva = medirConsulta([&] { agruparPorCiudad(compacta, gruposCompacta); });
+                mostrarComparacion("Agrupar por ciudad", original, nueva, mismosGrupos(gruposOriginal, gruposCompacta));
+
+                original = medirConsulta([&] { agruparPorDeclaracion(*personas, gruposOriginal); });
+                nueva = medirConsulta([&] { agruparPorDeclaracion(compacta.personas, gruposCompacta); });
+                mostrarComparacion("Agrupar por declaración", original, nueva, mismosGrupos(gruposOriginal, gruposCompacta));
+
+                original = medirConsulta([&] { declarantePorCiudad(*personas, gruposOriginal); });
+                nueva = medirConsulta([&] { declarantePorCiudad(compacta, gruposCompacta); });
+                mostrarComparacion("Declarantes por ciudad", original, nueva, mismosGrupos(gruposOriginal, gruposCompacta));
+
+                std::map<std::string, int> contadorOriginal, contadorCompacta;
+                original = medirConsulta([&] { agruparDeclarantesPorCalendario_ptr(*personas, &contadorOriginal); });
+                nueva = medirConsulta([&] { agruparDeclarantesPorCalendario_ptr(compacta.personas, &contadorCompacta); });
+                mostrarComparacion("Calendario", original, nueva, contadorOriginal == contadorCompacta);
+
+                std::cout << "\n[COMPACTA] Mayor deuda : ";
+                expandir(compacta, r).mostrarResumen();
+                std::cout << "\n";
+
+                double t = monitor.detener_tiempo();
+                long mem = monitor.obtener_memoria() - memoria_inicio;
+                monitor.registrar("Comparar registro compacto", t, mem);
+                break;
+            }
+
             default:
                 std::cout << "Opción inválida!\n";
         }
@@ -0,0 +1,342 @@
+#ifndef PERSONA_COMPACTA_H
+#define PERSONA_COMPACTA_H
+
+#include "persona.h"
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Versión compacta de Persona: los textos son índices a las tablas de la
+// colección, el ID es un entero, la fecha va empaquetada en 16 bits y el dinero
+// en centavos. Ocupa 32 bytes, así que caben 2 registros por línea de caché.
+struct alignas(32) PersonaCompacta {
+    uint32_t id;              // Número de documento
+    uint16_t fecha;           // (año - 1900) << 9 | mes << 5 | día
+    uint8_t  nombre;          // Índice en ColeccionCompacta::nombres
+    uint8_t  ciudad;          // Índice en ColeccionCompacta::ciudades
+    uint64_t ingresos   : 40; // Centavos (hasta ~11 mil millones de pesos)
+    uint64_t apellido   : 16; // Índice en ColeccionCompacta::apellidos
+    uint64_t declarante : 1;  // Si está obligado a declarar renta
+    int64_t  patrimonio;      // Centavos
+    int64_t  deudas;          // Centavos
+};
+
+static_assert(sizeof(PersonaCompacta) == 32, "PersonaCompacta debe ocupar 32 bytes");
+
+// Registros compactos junto con las tablas de textos a las que apuntan
+struct ColeccionCompacta {
+    std::vector<PersonaCompacta> personas;
+    std::vector<std::string> nombres;
+    std::vector<std::string> apellidos;
+    std::vector<std::string> ciudades;
+};
+
+// ================================ Conversión ==========================================
+
+// Índice de 'texto' en 'tabla', agregándolo si aún no existe
+inline size_t indiceEnTabla(const std::string& texto, std::vector<std::string>& tabla,
+                            std::map<std::string, size_t>& indices, size_t maximo) {
+    std::map<std::string, size_t>::const_iterator it = indices.find(texto);
+    if (it != indices.end()) return it->second;
+    if (tabla.size() >= maximo) {
+        throw std::runtime_error("Demasiados textos distintos para el registro compacto: " + texto);
+    }
+    indices[texto] = tabla.size();
+    tabla.push_back(texto);
+    return tabla.size() - 1;
+}
+
+inline int64_t aCentavos(double valor) {
+    return std::llround(valor * 100.0);
+}
+
+inline uint16_t empaquetarFecha(int anio, int mes, int dia) {
+    if (anio < 1900 || anio > 2027 || mes < 1 || mes > 12 || dia < 1 || dia > 31) {
+        throw std::runtime_error("Fecha no representable en el registro compacto");
+    }
+    return static_cast<uint16_t>((anio - 1900) << 9 | mes << 5 | dia);
+}
+
+inline void desempaquetarFecha(uint16_t fecha, int& anio, int& mes, int& dia) {
+    anio = 1900 + (fecha >> 9);
+    mes = (fecha >> 5) & 0xF;
+    dia = fecha & 0x1F;
+}
+
+// Convierte la colección al formato compacto. La fecha se guarda tal como la
+// interpreta calcularEdad para que las consultas den los mismos resultados.
+inline ColeccionCompacta compactar(const std::vector<Persona>& personas) {
+    ColeccionCompacta c;
+    c.personas.resize(personas.size());
+    std::map<std::string, size_t> indicesNombres, indicesApellidos, indicesCiudades;
+
+    for (size_t i = 0; i < personas.size(); ++i) {
+        const Persona& p = personas[i];
+        PersonaCompacta& r = c.personas[i];
+
+        char* fin = nullptr;
+        const unsigned long long id = std::strtoull(p.id.c_str(), &fin, 10);
+        if (p.id.empty() || !std::isdigit(static_cast<unsigned char>(p.id[0])) || *fin != '\0' || id > UINT32_MAX) {
+            throw std::runtime_error("ID no representable en el registro compacto: " + p.id);
+        }
+        r.id = static_cast<uint32_t>(id);
+
+        int anio, mes, dia;
+        descomponerFechaYMD(p.fechaNacimiento, anio, mes, dia);
+        r.fecha = empaquetarFecha(anio, mes, dia);
+
+        r.nombre = static_cast<uint8_t>(indiceEnTabla(p.nombre, c.nombres, indicesNombres, 1u << 8));
+        r.apellido = indiceEnTabla(p.apellido, c.apellidos, indicesApellidos, 1u << 16);
+        r.ciudad = static_cast<uint8_t>(indiceEnTabla(p.ciudadNacimiento, c.ciudades, indicesCiudades, 1u << 8));
+
+        const int64_t ingresos = aCentavos(p.ingresosAnuales);
+        if (ingresos < 0 || ingresos >= (int64_t(1) << 40)) {
+            throw std::runtime_error("Ingresos fuera de rango para el registro compacto (ID " + p.id + ")");
+        }
+        r.ingresos = static_cast<uint64_t>(ingresos);
+        r.patrimonio = aCentavos(p.patrimonio);
+        r.deudas = aCentavos(p.deudas);
+        r.declarante = p.declaranteRenta;
+    }
+    return c;
+}
+
+// Reconstruye la Persona completa (para mostrarla con los métodos de siempre)
+inline Persona expandir(const ColeccionCompacta& c, const PersonaCompacta& r) {
+    Persona p;
+    p.nombre = c.nombres[r.nombre];
+    p.apellido = c.apellidos[r.apellido];
+    p.id = std::to_string(r.id);
+    p.ciudadNacimiento = c.ciudades[r.ciudad];
+
+    int anio, mes, dia;
+    desempaquetarFecha(r.fecha, anio, mes, dia);
+    char fecha[32];
+    std::snprintf(fecha, sizeof(fecha), "%02d/%02d/%04d", dia, mes, anio);
+    p.fechaNacimiento = fecha;
+
+    p.ingresosAnuales = r.ingresos / 100.0;
+    p.patrimonio = r.patrimonio / 100.0;
+    p.deudas = r.deudas / 100.0;
+    p.declaranteRenta = r.declarante;
+    return p;
+}
+
+// ================================ Huella en memoria ==========================================
+
+// Bytes en el heap de un string (0 si cabe en su buffer interno)
+inline size_t bytesTexto(const std::string& s) {
+    const uintptr_t objeto = reinterpret_cast<uintptr_t>(&s);
+    const uintptr_t datos = reinterpret_cast<uintptr_t>(s.data());
+    return (datos >= objeto && datos < objeto + sizeof(s)) ? 0 : s.capacity() + 1;
+}
+
+inline size_t huellaPersonas(const std::vector<Persona>& personas) {
+    size_t total = personas.capacity() * sizeof(Persona);
+    for (const auto& p : personas) {
+        total += bytesTexto(p.nombre) + bytesTexto(p.apellido) + bytesTexto(p.id)
+               + bytesTexto(p.ciudadNacimiento) + bytesTexto(p.fechaNacimiento);
+    }
+    return total;
+}
+
+inline size_t huellaTabla(const std::vector<std::string>& tabla) {
+    size_t total = tabla.capacity() * sizeof(std::string);
+    for (const auto& s : tabla) total += bytesTexto(s);
+    return total;
+}
+
+inline size_t huellaCompacta(const ColeccionCompacta& c) {
+    return c.personas.capacity() * sizeof(PersonaCompacta)
+         + huellaTabla(c.nombres) + huellaTabla(c.apellidos) + huellaTabla(c.ciudades);
+}
+
+// ================================ Auxiliares de consulta ==========================================
+
+inline int calcularEdad(const PersonaCompacta& persona) {
+    int anioN, mesN, diaN; desempaquetarFecha(persona.fecha, anioN, mesN, diaN);
+    int anioH, mesH, diaH; obtenerHoyYMD(anioH, mesH, diaH);
+
+    int edad = anioH - anioN;
+    if (mesH < mesN || (mesH == mesN && diaH < diaN)) --edad;
+    return edad;
+}
+
+const char* const ETIQUETAS_GRUPO_DIAN[3] = {"Grupo A", "Grupo B", "Grupo C"};
+
+// Grupo DIAN (0 = A, 1 = B, 2 = C) según los dos últimos dígitos del ID
+inline int grupoDIANCompacto(const PersonaCompacta& persona) {
+    const uint32_t ultimosDos = persona.id % 100;
+    return ultimosDos <= 39 ? 0 : (ultimosDos <= 79 ? 1 : 2);
+}
+
+// Reparte por índice de ciudad y pasa al mapa por nombre cada ciudad presente.
+// Con 'soloDeclarantes' la ciudad se conserva aunque quede vacía, como en declarantePorCiudad.
+inline void agruparCompactaPorCiudad(const ColeccionCompacta& c, bool soloDeclarantes,
+    std::map<std::string, std::vector<PersonaCompacta>>& grupos) {
+
+    std::vector<std::vector<PersonaCompacta>> porIndice(c.ciudades.size());
+    std::vector<char> presente(c.ciudades.size(), 0);
+    for (const auto& p : c.personas) {
+        presente[p.ciudad] = 1;
+        if (!soloDeclarantes || p.declarante) porIndice[p.ciudad].push_back(p);
+    }
+
+    grupos.clear();
+    for (size_t i = 0; i < porIndice.size(); ++i) {
+        if (presente[i]) grupos[c.ciudades[i]] = std::move(porIndice[i]);
+    }
+}
+
+// ***************************** Búsquedas sobre registros compactos *************************************
+
+inline void personaMaxLongeva(const std::vector<PersonaCompacta>& personas, PersonaCompacta& longeva) {
+    if (personas.empty()) {
+        throw std::runtime_error("La lista está vacía");
+    }
+    longeva = *std::max_element(personas.begin(), personas.end(),
+                [](const PersonaCompacta& a, const PersonaCompacta& b) {
+                    return calcularEdad(a) < calcularEdad(b);
+                });
+}
+
+inline PersonaCompacta personaMaxLongevaValor(std::vector<PersonaCompacta> personas) {
+    PersonaCompacta longeva;
+    personaMaxLongeva(personas, longeva);
+    return longeva;
+}
+
+inline void personaMaxPatrimonio(const std::vector<PersonaCompacta>& personas, PersonaCompacta& maxPatrimonio) {
+    if (personas.empty()) {
+        throw std::runtime_error("La lista está vacía");
+    }
+    maxPatrimonio = *std::max_element(personas.begin(), personas.end(),
+                    [](const PersonaCompacta& a, const PersonaCompacta& b) {
+                        return a.patrimonio < b.patrimonio;
+                    });
+}
+
+inline PersonaCompacta personaMaxPatrimonioValor(std::vector<PersonaCompacta> personas) {
+    PersonaCompacta maxPatrimonio;
+    personaMaxPatrimonio(personas, maxPatrimonio);
+    return maxPatrimonio;
+}
+
+inline void personaMinPatrimonio(const std::vector<PersonaCompacta>& personas, PersonaCompacta& minPatrimonio) {
+    if (personas.empty()) {
+        throw std::runtime_error("La lista está vacía");
+    }
+    minPatrimonio = *std::min_element(personas.begin(), personas.end(),
+                    [](const PersonaCompacta& a, const PersonaCompacta& b) {
+                        return a.patrimonio < b.patrimonio;
+                    });
+}
+
+inline PersonaCompacta personaMinPatrimonioValor(std::vector<PersonaCompacta> personas) {
+    PersonaCompacta minPatrimonio;
+    personaMinPatrimonio(personas, minPatrimonio);
+    return minPatrimonio;
+}
+
+inline void personaMaxDeuda(const std::vector<PersonaCompacta>& personas, PersonaCompacta& maxDeuda) {
+    if (personas.empty()) {
+        throw std::runtime_error("La lista está vacía");
+    }
+    maxDeuda = *std::max_element(personas.begin(), personas.end(),
+            [](const PersonaCompacta& a, const PersonaCompacta& b) {
+                return a.deudas < b.deudas;
+            });
+}
+
+inline PersonaCompacta personaMaxDeudaValor(std::vector<PersonaCompacta> personas) {
+    PersonaCompacta maxDeuda;
+    personaMaxDeuda(personas, maxDeuda);
+    return maxDeuda;
+}
+
+// ***************************** Agrupaciones sobre registros compactos *************************************
+
+inline void agruparPorCiudad(const ColeccionCompacta& coleccion,
+    std::map<std::string, std::vector<PersonaCompacta>>& grupos) {
+    agruparCompactaPorCiudad(coleccion, false, grupos);
+}
+
+inline std::map<std::string, std::vector<PersonaCompacta>> agruparPorCiudadValor(const ColeccionCompacta coleccion) {
+    std::map<std::string, std::vector<PersonaCompacta>> grupos;
+    agruparCompactaPorCiudad(coleccion, false, grupos);
+    return grupos;
+}
+
+inline void declarantePorCiudad(const ColeccionCompacta& coleccion,
+    std::map<std::string, std::vector<PersonaCompacta>>& grupos) {
+    agruparCompactaPorCiudad(coleccion, true, grupos);
+}
+
+inline std::map<std::string, std::vector<PersonaCompacta>> declarantePorCiudadValor(const ColeccionCompacta coleccion) {
+    std::map<std::string, std::vector<PersonaCompacta>> grupos;
+    agruparCompactaPorCiudad(coleccion, true, grupos);
+    return grupos;
+}
+
+inline void agruparPorDeclaracion(const std::vector<PersonaCompacta>& personas,
+    std::map<std::string, std::vector<PersonaCompacta>>& grupos) {
+
+    std::vector<PersonaCompacta> porGrupo[3];
+    for (const auto& p : personas) porGrupo[grupoDIANCompacto(p)].push_back(p);
+
+    grupos.clear();
+    for (int g = 0; g < 3; ++g) {
+        if (!porGrupo[g].empty()) grupos[ETIQUETAS_GRUPO_DIAN[g]] = std::move(porGrupo[g]);
+    }
+}
+
+inline std::map<std::string, std::vector<PersonaCompacta>> agruparPorDeclaracionValor(
+    std::vector<PersonaCompacta> personas) {
+    std::map<std::string, std::vector<PersonaCompacta>> grupos;
+    agruparPorDeclaracion(personas, grupos);
+    return grupos;
+}
+
+// ==================== Calendario DIAN 2025 sobre registros compactos ===========================
+struct CalendarioCompacto {
+    std::map<std::string, std::vector<PersonaCompacta>> grupos;
+    std::map<std::string, int> conteo;
+};
+
+inline std::map<std::string, std::vector<const PersonaCompacta*>>
+agruparDeclarantesPorCalendario_ptr(const std::vector<PersonaCompacta>& personas,
+std::map<std::string, int>* contador = nullptr) {
+
+    std::vector<const PersonaCompacta*> porGrupo[3];
+    for (const auto& p : personas) {
+        if (p.declarante) porGrupo[grupoDIANCompacto(p)].push_back(&p);
+    }
+
+    std::map<std::string, std::vector<const PersonaCompacta*>> grupos;
+    for (int g = 0; g < 3; ++g) {
+        if (contador) (*contador)[ETIQUETAS_GRUPO_DIAN[g]] = static_cast<int>(porGrupo[g].size());
+        if (!porGrupo[g].empty()) grupos[ETIQUETAS_GRUPO_DIAN[g]] = std::move(porGrupo[g]);
+    }
+    return grupos;
+}
+
+inline CalendarioCompacto agruparDeclarantesPorCalendario_valor(const std::vector<PersonaCompacta> personas) {
+    CalendarioCompacto res;
+    for (int g = 0; g < 3; ++g) res.grupos[ETIQUETAS_GRUPO_DIAN[g]];
+
+    for (const auto& p : personas) {
+        if (p.declarante) res.grupos[ETIQUETAS_GRUPO_DIAN[grupoDIANCompacto(p)]].push_back(p);
+    }
+    for (int g = 0; g < 3; ++g) {
+        res.conteo[ETIQUETAS_GRUPO_DIAN[g]] = static_cast<int>(res.grupos[ETIQUETAS_GRUPO_DIAN[g]].size());
+    }
+    return res;
+}
+
+#endif